@@ -35,12 +35,12 @@ Action::Action( const std::string name, const std::string help_text )
 {}
 
 
-const std::string Action::name() const {
+const std::string& Action::name() const {
     return m_name;
 }
 
 
-const std::string Action::help_text() const {
+const std::string& Action::help_text() const {
     return m_help_text;
 }
 
@@ -58,13 +58,13 @@ public:
      * @brief Get the name of the action
      * @returns The name of the action
      */
-    const std::string name() const;
+    const std::string& name() const;
     
     /**
      * @brief Get the help text
      * @returns The help text
      */
-    const std::string help_text() const;
+    const std::string& help_text() const;
     
     /**
      * @brief Add a string to the help text.
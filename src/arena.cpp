@@ -0,0 +1,252 @@
+/**
+ * @file arena.cpp
+ * @brief A file that defines the memory resources used for the parse state
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "arena.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief The size of the first chunk, if the arena has no buffer of the caller
+ */
+const size_t first_chunk_size = 1024;
+
+/**
+ * @brief The size of a chunk header, so the memory behind it is aligned for every type
+ */
+const size_t chunk_header_size = ( sizeof( void* ) + sizeof( size_t ) + alignof( std::max_align_t ) - 1 )
+                               & ~( alignof( std::max_align_t ) - 1 );
+
+
+/**
+ * @brief A memory resource that uses the global operator new and delete
+ */
+class NewDeleteResource : public MemoryResource {
+protected:
+    void* do_allocate( size_t bytes, size_t alignment ) {
+        if ( alignment <= alignof( std::max_align_t ) ) {
+            return ::operator new( bytes );
+        }
+#ifdef __unix__
+        void* p = nullptr;
+        if ( posix_memalign( &p, alignment, bytes > 0 ? bytes : 1 ) != 0 ) {
+            throw std::bad_alloc();
+        }
+        return p;
+#else
+        // operator new of C++11 only aligns for the fundamental types
+        throw std::bad_alloc();
+#endif
+    }
+    void do_deallocate( void* p, size_t /*bytes*/, size_t alignment ) {
+        if ( alignment <= alignof( std::max_align_t ) ) {
+            ::operator delete( p );
+        } else {
+            std::free( p );
+        }
+    }
+};
+
+} // namespace
+
+
+MemoryResource::~MemoryResource() {}
+
+
+void* MemoryResource::allocate( size_t bytes, size_t alignment ) {
+    return this->do_allocate( bytes, alignment );
+}
+
+
+void MemoryResource::deallocate( void* p, size_t bytes, size_t alignment ) {
+    this->do_deallocate( p, bytes, alignment );
+}
+
+
+bool MemoryResource::is_equal( const MemoryResource& other ) const {
+    return this->do_is_equal( other );
+}
+
+
+bool MemoryResource::do_is_equal( const MemoryResource& other ) const {
+    return this == &other;
+}
+
+
+MemoryResource* new_delete_resource() {
+    // Never destroyed, so containers may still give back memory during static destruction
+    static NewDeleteResource* resource = new NewDeleteResource();
+    return resource;
+}
+
+
+MonotonicArena::MonotonicArena( MemoryResource* upstream )
+    :   m_upstream( upstream )
+    ,   m_initial_buffer( nullptr )
+    ,   m_initial_size( 0 )
+    ,   m_chunks( nullptr )
+    ,   m_current( nullptr )
+    ,   m_end( nullptr )
+    ,   m_next_size( first_chunk_size )
+    ,   m_used( 0 )
+    ,   m_allocations( 0 )
+{}
+
+
+MonotonicArena::MonotonicArena( void* buffer, size_t size, MemoryResource* upstream )
+    :   m_upstream( upstream )
+    ,   m_initial_buffer( static_cast< char* >( buffer ) )
+    ,   m_initial_size( size )
+    ,   m_chunks( nullptr )
+    ,   m_current( static_cast< char* >( buffer ) )
+    ,   m_end( static_cast< char* >( buffer ) + size )
+    ,   m_next_size( size < first_chunk_size ? first_chunk_size : size * 2 )
+    ,   m_used( 0 )
+    ,   m_allocations( 0 )
+{}
+
+
+MonotonicArena::~MonotonicArena() {
+    this->free_chunks();
+}
+
+
+void MonotonicArena::free_chunks() {
+    while ( m_chunks != nullptr ) {
+        Chunk* next = m_chunks->next;
+        m_upstream->deallocate( m_chunks, chunk_header_size + m_chunks->size, alignof( std::max_align_t ) );
+        m_chunks = next;
+    }
+}
+
+
+void MonotonicArena::grow( size_t bytes ) {
+    size_t size = m_next_size;
+    while ( size < bytes ) {
+        size *= 2;
+    }
+
+    Chunk* chunk = static_cast< Chunk* >( m_upstream->allocate( chunk_header_size + size, alignof( std::max_align_t ) ) );
+    chunk->next = m_chunks;
+    chunk->size = size;
+    m_chunks = chunk;
+
+    m_current = reinterpret_cast< char* >( chunk ) + chunk_header_size;
+    m_end = m_current + size;
+    m_next_size = size * 2;
+}
+
+
+void* MonotonicArena::do_allocate( size_t bytes, size_t alignment ) {
+    uintptr_t address = reinterpret_cast< uintptr_t >( m_current );
+    size_t padding = ( alignment - ( address & ( alignment - 1 ) ) ) & ( alignment - 1 );
+
+    if ( m_current == nullptr || padding + bytes > static_cast< size_t >( m_end - m_current ) ) {
+        this->grow( bytes + alignment );
+        address = reinterpret_cast< uintptr_t >( m_current );
+        padding = ( alignment - ( address & ( alignment - 1 ) ) ) & ( alignment - 1 );
+    }
+
+    char* p = m_current + padding;
+    m_current = p + bytes;
+    m_used += padding + bytes;
+    ++m_allocations;
+    return p;
+}
+
+
+void MonotonicArena::do_deallocate( void* /*p*/, size_t /*bytes*/, size_t /*alignment*/ ) {
+    // Memory is given back all at once by release
+}
+
+
+void MonotonicArena::release() {
+    const size_t needed = m_used;
+    m_used = 0;
+    m_allocations = 0;
+
+    if ( m_initial_buffer != nullptr && needed <= m_initial_size ) {
+        // Everything fits into the buffer of the caller again
+        this->free_chunks();
+        m_current = m_initial_buffer;
+        m_end = m_initial_buffer + m_initial_size;
+        return;
+    }
+
+    // Keep the newest chunk, if it can hold everything of the last round, so the next round does not allocate
+    Chunk* keep = nullptr;
+    if ( m_chunks != nullptr && m_chunks->size >= needed ) {
+        keep = m_chunks;
+        m_chunks = m_chunks->next;
+    }
+    this->free_chunks();
+
+    if ( keep == nullptr ) {
+        m_current = nullptr;
+        m_end = nullptr;
+        if ( needed > 0 ) {
+            m_next_size = first_chunk_size;
+            this->grow( needed );
+        }
+        return;
+    }
+
+    keep->next = nullptr;
+    m_chunks = keep;
+    m_current = reinterpret_cast< char* >( keep ) + chunk_header_size;
+    m_end = m_current + keep->size;
+}
+
+
+size_t MonotonicArena::used() const {
+    return m_used;
+}
+
+
+size_t MonotonicArena::capacity() const {
+    size_t capacity = m_initial_size;
+    for ( const Chunk* chunk = m_chunks; chunk != nullptr; chunk = chunk->next ) {
+        capacity += chunk->size;
+    }
+    return capacity;
+}
+
+
+size_t MonotonicArena::allocations() const {
+    return m_allocations;
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,227 @@
+/**
+ * @file arena.hpp
+ * @brief A file that defines the memory resources used for the parse state
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief An interface for classes that provide memory, modelled after std::pmr::memory_resource
+ * @note This is a small C++11 replacement for std::pmr::memory_resource, so the parse state can be placed in memory supplied by the caller.
+ */
+class MemoryResource {
+public:
+    virtual ~MemoryResource();
+
+    /**
+     * @brief Allocate memory
+     * @param bytes The number of bytes to allocate
+     * @param alignment The alignment of the memory, a power of 2
+     * @returns A pointer to the memory
+     * @throws std::bad_alloc If no memory is left
+     */
+    void* allocate( size_t bytes, size_t alignment = alignof( std::max_align_t ) );
+    /**
+     * @brief Give back memory returned by allocate
+     * @param p The pointer returned by allocate
+     * @param bytes The number of bytes passed to allocate
+     * @param alignment The alignment passed to allocate
+     */
+    void deallocate( void* p, size_t bytes, size_t alignment = alignof( std::max_align_t ) );
+    /**
+     * @brief Test, if memory allocated from this resource can be given back to another one
+     * @param other The other resource
+     * @returns True, if both resources are the same
+     */
+    bool is_equal( const MemoryResource& other ) const;
+
+protected:
+    virtual void* do_allocate( size_t bytes, size_t alignment ) = 0;
+    virtual void do_deallocate( void* p, size_t bytes, size_t alignment ) = 0;
+    virtual bool do_is_equal( const MemoryResource& other ) const;
+};
+
+
+/**
+ * @brief Get the resource that uses the global operator new and delete
+ * @returns The global resource. It is never destroyed.
+ * @note Alignments above alignof( std::max_align_t ) are allocated with posix_memalign. Without it they throw std::bad_alloc.
+ */
+MemoryResource* new_delete_resource();
+
+
+/**
+ * @brief A memory resource that hands out memory from large chunks and frees it all at once
+ *
+ * Single deallocations do nothing. release gives back all memory in one step, but keeps one chunk
+ * big enough for everything allocated since the last release. So a program that parses the same
+ * kind of command line again and again allocates from the upstream resource only the first time.
+ */
+class MonotonicArena : public MemoryResource {
+    /**
+     * @brief The header in front of every chunk allocated from upstream
+     */
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    MemoryResource* m_upstream;
+    char* m_initial_buffer;
+    size_t m_initial_size;
+    Chunk* m_chunks;
+    char* m_current;
+    char* m_end;
+    size_t m_next_size;
+    size_t m_used;
+    size_t m_allocations;
+
+    /**
+     * @brief Allocate a new chunk from upstream that has room for at least bytes
+     * @param bytes The number of bytes needed
+     */
+    void grow( size_t bytes );
+    /**
+     * @brief Give back all chunks to upstream
+     */
+    void free_chunks();
+
+public:
+    /**
+     * @brief Constructor. Allocates chunks from upstream when it is needed.
+     * @param upstream The resource to allocate the chunks from
+     */
+    explicit MonotonicArena( MemoryResource* upstream = new_delete_resource() );
+    /**
+     * @brief Constructor. Uses a buffer of the caller first and allocates further chunks from upstream.
+     * @param buffer The buffer to use first. It has to outlive this arena.
+     * @param size The size of buffer in bytes
+     * @param upstream The resource to allocate further chunks from
+     */
+    MonotonicArena( void* buffer, size_t size, MemoryResource* upstream = new_delete_resource() );
+    /**
+     * @brief Destructor. Gives back all chunks to upstream.
+     */
+    ~MonotonicArena();
+
+    MonotonicArena( const MonotonicArena& ) = delete;
+    MonotonicArena& operator=( const MonotonicArena& ) = delete;
+
+    /**
+     * @brief Give back all memory allocated from this arena at once
+     * @warning Everything allocated from this arena is invalid afterwards
+     */
+    void release();
+    /**
+     * @brief Get the number of bytes handed out since the last release
+     * @returns The number of bytes including alignment padding
+     */
+    size_t used() const;
+    /**
+     * @brief Get the number of bytes held from upstream
+     * @returns The size of all chunks
+     */
+    size_t capacity() const;
+    /**
+     * @brief Get the number of allocations since the last release
+     * @returns The number of allocations served, whether they needed a new chunk or not
+     */
+    size_t allocations() const;
+
+protected:
+    void* do_allocate( size_t bytes, size_t alignment );
+    void do_deallocate( void* p, size_t bytes, size_t alignment );
+};
+
+
+/**
+ * @brief An allocator for standard containers that allocates from a MemoryResource, like std::pmr::polymorphic_allocator
+ */
+template< typename T >
+class ArenaAllocator {
+    MemoryResource* m_resource;
+
+    template< typename U >
+    friend class ArenaAllocator;
+
+public:
+    typedef T value_type;
+
+    /**
+     * @brief Constructor. Allocates with new and delete.
+     */
+    ArenaAllocator()
+        :   m_resource( new_delete_resource() )
+    {}
+    /**
+     * @brief Constructor.
+     * @param resource The resource to allocate from. It has to outlive every container using this allocator.
+     */
+    ArenaAllocator( MemoryResource* resource )
+        :   m_resource( resource )
+    {}
+    template< typename U >
+    ArenaAllocator( const ArenaAllocator< U >& other )
+        :   m_resource( other.m_resource )
+    {}
+
+    T* allocate( size_t n ) {
+        return static_cast< T* >( m_resource->allocate( n * sizeof( T ), alignof( T ) ) );
+    }
+    void deallocate( T* p, size_t n ) {
+        m_resource->deallocate( p, n * sizeof( T ), alignof( T ) );
+    }
+
+    /**
+     * @brief Get the resource this allocator allocates from
+     */
+    MemoryResource* resource() const {
+        return m_resource;
+    }
+
+    template< typename U >
+    bool operator==( const ArenaAllocator< U >& other ) const {
+        return m_resource->is_equal( *other.m_resource );
+    }
+    template< typename U >
+    bool operator!=( const ArenaAllocator< U >& other ) const {
+        return !( *this == other );
+    }
+};
+
+
+/**
+ * @brief A std::vector that allocates from a MemoryResource
+ */
+template< typename T >
+using ArenaVector = std::vector< T, ArenaAllocator< T > >;
+
+
+} // namespace cmdlinecpp
@@ -23,12 +23,66 @@
     USA
 */
 
+#include <algorithm>
+
 #include "arguments.hpp"
+#include "suggestions.hpp"
 
 
 namespace cmdlinecpp {
 
 
+namespace {
+
+/**
+ * @brief Get the bytes a string holds on the heap, nothing if it is short enough to be stored inline
+ * @note An empty string has the capacity of the inline buffer, a string that does not fit into it is on the heap.
+ */
+size_t string_heap_bytes( const std::string& text ) {
+    static const size_t inline_capacity = std::string().capacity();
+    if ( text.capacity() <= inline_capacity ) {
+        return 0;
+    }
+    return text.capacity() + 1;
+}
+
+
+/**
+ * @brief Sort ids by a name
+ * @param sorted Is filled with the ids from 0 to count - 1, ordered by name( id )
+ */
+template< typename Name >
+void sort_by_name( std::vector< uint32_t >& sorted, size_t count, Name name ) {
+    sorted.resize( count );
+    for ( uint32_t i = 0; i < count; i++ ) {
+        sorted[i] = i;
+    }
+    std::stable_sort( sorted.begin(), sorted.end(), [&name]( uint32_t a, uint32_t b ) {
+        return name( a ) < name( b );
+    } );
+}
+
+
+/**
+ * @brief Find the ids in a list ordered by name, whose name starts with a prefix
+ * @returns The range of the ids in sorted
+ */
+template< typename Name >
+std::pair< const uint32_t*, const uint32_t* > prefix_range( const std::vector< uint32_t >& sorted, const StringView& prefix, Name name ) {
+    const uint32_t* first = std::lower_bound( sorted.data(), sorted.data() + sorted.size(), prefix
+                                            , [&name]( uint32_t id, const StringView& p ) {
+                                                  return StringView( name( id ) ).compare( p ) < 0;
+                                              } );
+    const uint32_t* last = std::upper_bound( first, sorted.data() + sorted.size(), prefix
+                                           , [&name]( const StringView& p, uint32_t id ) {
+                                                 return p.compare( StringView( name( id ) ).substr( 0, p.length() ) ) < 0;
+                                             } );
+    return std::make_pair( first, last );
+}
+
+} // namespace
+
+
 Data::Data()
     :   m_key()
     ,   m_appearence()
@@ -37,7 +91,7 @@ Data::Data()
 
 Data::Data( const std::string key )
     :   m_key( key )
-    ,   m_appearence( 1 )
+    ,   m_appearence( 0 )
 {}
 
 
@@ -49,14 +103,14 @@ Data::Data( const std::string key
 
 
 bool Data::is_valid() const {
-    if ( m_appearence > 0 && m_key.length() > 0 ) {
+    if ( m_key.length() > 0 ) {
         return true;
     }
     return false;
 }
 
 
-const std::string Data::key() const {
+const std::string& Data::key() const {
     return m_key;
 }
 
@@ -72,6 +126,7 @@ Option::Option( const std::string option_long
     :   m_option( option_long, std::string("") )
     ,   m_help_text( help_text )
     ,   m_data_type( data_type )
+    ,   m_environment_variable()
 {}
 
 
@@ -82,6 +137,7 @@ Option::Option( const std::string option_long
     :   m_option( option_long, option_short )
     ,   m_help_text( help_text )
     ,   m_data_type( data_type )
+    ,   m_environment_variable()
 {
     if ( m_option.second.length() == 0 ) {
         throw std::logic_error("The parameter option_short does not need to be the empty string.");
@@ -117,21 +173,33 @@ const Data::Type Option::dataType() const {
 }
 
 
-const std::string Option::option() const {
+const std::string& Option::option() const {
     return m_option.first;
 }
 
 
-const std::string Option::option_short() const {
+const std::string& Option::option_short() const {
     return m_option.second;
 }
 
 
-const std::string Option::help_text() const {
+const std::string& Option::help_text() const {
     return m_help_text;
 }
 
 
+const std::string& Option::environment_variable() const {
+    return m_environment_variable;
+}
+
+
+Option& Option::from_environment( const std::string& variable ) {
+    m_environment_variable = variable;
+    
+    return *this;
+}
+
+
 
 Option& Option::operator<<( const std::string help_text ) {
     std::string help = help_text;
@@ -149,82 +217,260 @@ Option& Option::operator<<( const std::string help_text ) {
 
 
 CmdLineArguments::CmdLineArguments()
+    :   m_actions()
+    ,   m_positionals()
+    ,   m_options()
+    ,   m_frozen( false )
+    ,   m_token_index()
+    ,   m_name_index()
+    ,   m_action_index()
+    ,   m_defined_names()
+    ,   m_defined_hashes()
+    ,   m_defined_count( 0 )
+    ,   m_environment_index()
+    ,   m_environment_prefix()
+    ,   m_positional_source()
+    ,   m_sorted_long()
+    ,   m_sorted_short()
+    ,   m_sorted_actions()
 {}
 
 
 void CmdLineArguments::add_option( Option option ) {
     if ( option.is_positional() ) {
-        this->add_option_positional( option );
+        this->add_option_positional( std::move( option ) );
     } else {
-        this->add_option_regular( option );
+        this->add_option_regular( std::move( option ) );
     }
 }
 
 
 void CmdLineArguments::add_action( Action action ) {
-    bool found = false;
-    for ( unsigned int a = 0; a < m_actions.size(); a++ ) {
-        if ( action.name().compare( m_actions.at(a).name() ) == 0 ) {
-            found = true;
-            break;
-        }
-    }
-    
+    this->thaw();
     m_actions.push_back( action );
 }
 
 
 void CmdLineArguments::add_option_positional( Option option ) {
-    m_positionals.push_back( option );
+    this->thaw();
+    m_positionals.push_back( std::move( option ) );
+    this->define_name( static_cast< uint32_t >( m_positionals.size() - 1 ) * 2 + 2 );
 }
 
 
 void CmdLineArguments::add_option_regular( Option option ) {
-    m_options.push_back( option );
+    this->thaw();
+    m_options.push_back( std::move( option ) );
+    this->define_name( static_cast< uint32_t >( m_options.size() - 1 ) * 2 + 1 );
+}
+
+
+void CmdLineArguments::thaw() {
+    m_frozen = false;
+    
+    if ( m_defined_count != m_options.size() + m_positionals.size() ) {
+        this->rebuild_defined_names();
+    }
+}
+
+
+const std::string& CmdLineArguments::defined_name( uint32_t slot ) const {
+    if ( slot % 2 == 1 ) {
+        return m_options[ ( slot - 1 ) / 2 ].option();
+    }
+    return m_positionals[ ( slot - 2 ) / 2 ].option();
+}
+
+
+void CmdLineArguments::define_name( uint32_t slot ) {
+    if ( ( m_defined_count + 1 ) * 2 > m_defined_names.size() ) {
+        this->rebuild_defined_names();
+        if ( m_defined_count == m_options.size() + m_positionals.size() ) {
+            // The rebuild already contains the new option
+            return;
+        }
+    }
+    
+    const std::string& name = this->defined_name( slot );
+    const uint64_t hash = NameIndex::hash( name.data(), name.length() );
+    const size_t mask = m_defined_names.size() - 1;
+    size_t s = hash & mask;
+    while ( m_defined_names[s] != 0 ) {
+        s = ( s + 1 ) & mask;
+    }
+    m_defined_names[s] = slot;
+    m_defined_hashes[s] = hash;
+    ++m_defined_count;
 }
 
 
-bool CmdLineArguments::is_option_regular( const std::string parameter ) const {
-    std::string option_str;
-    if ( parameter.compare( 0, 1, "-" ) != 0 ) {
+void CmdLineArguments::rebuild_defined_names() {
+    const size_t count = m_options.size() + m_positionals.size();
+    size_t capacity = 16;
+    while ( capacity < count * 2 + 2 ) {
+        capacity <<= 1;
+    }
+    
+    m_defined_names.assign( capacity, 0 );
+    m_defined_hashes.assign( capacity, 0 );
+    m_defined_count = 0;
+    
+    const size_t mask = capacity - 1;
+    for ( size_t d = 0; d < count; d++ ) {
+        const uint32_t slot = d < m_options.size()
+                            ? static_cast< uint32_t >( d ) * 2 + 1
+                            : static_cast< uint32_t >( d - m_options.size() ) * 2 + 2;
+        const std::string& name = this->defined_name( slot );
+        const uint64_t hash = NameIndex::hash( name.data(), name.length() );
+        size_t s = hash & mask;
+        while ( m_defined_names[s] != 0 ) {
+            s = ( s + 1 ) & mask;
+        }
+        m_defined_names[s] = slot;
+        m_defined_hashes[s] = hash;
+        ++m_defined_count;
+    }
+}
+
+
+bool CmdLineArguments::has_name( const StringView& option_name ) const {
+    if ( m_frozen ) {
+        return m_name_index.find( option_name.data(), option_name.length() ) != NameIndex::npos;
+    }
+    if ( m_defined_count == 0 ) {
         return false;
-    } else if ( parameter.compare( 0, 2, "--" ) == 0 ) {
-        option_str = parameter.substr( 2 );
-    } else {
-        option_str = parameter.substr( 1 );
     }
     
+    const uint64_t hash = NameIndex::hash( option_name.data(), option_name.length() );
+    const size_t mask = m_defined_names.size() - 1;
+    for ( size_t s = hash & mask; m_defined_names[s] != 0; s = ( s + 1 ) & mask ) {
+        if ( m_defined_hashes[s] == hash && option_name == this->defined_name( m_defined_names[s] ) ) {
+            return true;
+        }
+    }
     
-    for ( unsigned int o = 0; o < m_options.size(); o++ ) {
-        Option option = m_options.at( o );
+    return false;
+}
+
+
+void CmdLineArguments::freeze() {
+    if ( m_frozen ) {
+        return;
+    }
+    
+    // Long and short specifiers are inserted in definition order, so the first
+    // definition wins on clashes just like with a linear search.
+    m_token_index.reset( m_options.size() * 2 );
+    m_name_index.reset( m_options.size() + m_positionals.size() );
+    for ( uint32_t o = 0; o < m_options.size(); o++ ) {
+        const Option& option = m_options[o];
+        m_token_index.insert( option.option().data(), option.option().length(), o );
+        m_token_index.insert( option.option_short().data(), option.option_short().length(), o );
+        m_name_index.insert( option.option().data(), option.option().length(), o );
+    }
+    
+    const uint32_t first_positional = static_cast< uint32_t >( m_options.size() );
+    for ( uint32_t p = 0; p < m_positionals.size(); p++ ) {
+        const Option& option = m_positionals[p];
+        m_name_index.insert( option.option().data(), option.option().length(), first_positional + p );
+    }
+    
+    // The common prefix lets the scan over the environment skip most variables with one compare
+    m_environment_index.reset( m_options.size() );
+    m_environment_prefix.clear();
+    bool first_variable = true;
+    for ( uint32_t o = 0; o < m_options.size(); o++ ) {
+        const std::string& variable = m_options[o].environment_variable();
+        if ( variable.empty() ) {
+            continue;
+        }
+        m_environment_index.insert( variable.data(), variable.length(), o );
         
-        if ( option_str.compare( option.option() ) == 0
-          || option_str.compare( option.option_short() ) == 0
-        ) {
-           return true; 
+        if ( first_variable ) {
+            m_environment_prefix = variable;
+            first_variable = false;
+        } else {
+            size_t length = 0;
+            while ( length < m_environment_prefix.length()
+                 && length < variable.length()
+                 && m_environment_prefix[length] == variable[length]
+            ) {
+                ++length;
+            }
+            m_environment_prefix.resize( length );
         }
     }
     
-    return false;
+    m_action_index.reset( m_actions.size() );
+    for ( uint32_t a = 0; a < m_actions.size(); a++ ) {
+        m_action_index.insert( m_actions[a].name().data(), m_actions[a].name().length(), a );
+    }
+    
+    this->sort_names();
+    m_frozen = true;
 }
 
 
-bool CmdLineArguments::is_option_positional( const std::string parameter ) const {
-    std::string option_str;
-    if ( parameter.compare( 0, 1, "-" ) == 0 ) {
-        return false;
+void CmdLineArguments::sort_names() {
+    sort_by_name( m_sorted_long, m_options.size(), [this]( uint32_t o ) -> const std::string& {
+        return m_options[o].option();
+    } );
+    sort_by_name( m_sorted_short, m_options.size(), [this]( uint32_t o ) -> const std::string& {
+        return m_options[o].option_short();
+    } );
+    sort_by_name( m_sorted_actions, m_actions.size(), [this]( uint32_t a ) -> const std::string& {
+        return m_actions[a].name();
+    } );
+}
+
+
+bool CmdLineArguments::is_frozen() const {
+    return m_frozen;
+}
+
+
+StringView CmdLineArguments::strip_dashes( const StringView& parameter ) {
+    if ( parameter.length() == 0 || parameter[0] != '-' ) {
+        return StringView( nullptr, 0 );
+    } else if ( parameter.length() > 1 && parameter[1] == '-' ) {
+        return parameter.substr( 2 );
     }
     
+    return parameter.substr( 1 );
+}
+
+
+uint32_t CmdLineArguments::find_regular( const StringView& option_str ) const {
+    if ( m_frozen ) {
+        return m_token_index.find( option_str.data(), option_str.length() );
+    }
     
-    for ( unsigned int o = 0; o < m_options.size(); o++ ) {
-        Option option = m_options.at( o );
+    for ( uint32_t o = 0; o < m_options.size(); o++ ) {
+        const Option& option = m_options[o];
         
-        if ( option_str.compare( option.option() ) == 0 ) {
-           return true; 
+        if ( option_str == option.option()
+          || option_str == option.option_short()
+        ) {
+            return o;
         }
     }
     
-    return false;
+    return NameIndex::npos;
+}
+
+
+bool CmdLineArguments::is_option_regular( const StringView& parameter ) const {
+    return this->option_id_of_parameter( parameter ) != NameIndex::npos;
+}
+
+
+bool CmdLineArguments::is_option_positional( const StringView& parameter ) const {
+    if ( parameter.starts_with( "-" ) ) {
+        return false;
+    }
+    
+    const uint32_t id = this->option_id( parameter );
+    return id != NameIndex::npos && id >= m_options.size();
 }
 
 
@@ -233,11 +479,13 @@ bool CmdLineArguments::are_actions_enabled() const {
 }
 
 
-bool CmdLineArguments::is_action( const std::string parameter ) const {
+bool CmdLineArguments::is_action( const StringView& parameter ) const {
+    if ( m_frozen ) {
+        return m_action_index.find( parameter.data(), parameter.length() ) != NameIndex::npos;
+    }
+    
     for ( unsigned int a = 0; a < m_actions.size(); a++ ) {
-        Action action = m_actions.at( a );
-        
-        if ( action.name().compare( parameter ) == 0 ) {
+        if ( parameter == m_actions[a].name() ) {
             return true;
         }
     }
@@ -246,55 +494,217 @@ bool CmdLineArguments::is_action( const std::string parameter ) const {
 }
 
 
-const Option CmdLineArguments::lookup_positional( const std::string option_name ) const {
-    for ( unsigned int o = 0; o < m_positionals.size(); o++ ) {
-        if ( m_positionals.at(o).option().compare(option_name) == 0 ) {
-            return m_positionals.at(o);
+const Option& CmdLineArguments::lookup_positional( const std::string& option_name ) const {
+    const uint32_t id = this->option_id( option_name );
+    if ( id == NameIndex::npos || id < m_options.size() ) {
+        std::vector< std::string > names;
+        for ( size_t p = 0; p < m_positionals.size(); p++ ) {
+            names.push_back( m_positionals[p].option() );
         }
+        throw NotFound("Could not find positional option '"  + option_name + "'." + Suggestions::did_you_mean( option_name, names ));
     }
+    
+    return m_positionals[ id - m_options.size() ];
+}
 
-    throw NotFound("Could not find positional option '"  + option_name + "'.");
+
+
+const Option& CmdLineArguments::lookup_option( const std::string& parameter ) const {
+    const uint32_t id = this->option_id_of_parameter( parameter );
+    if ( id == NameIndex::npos ) {
+        throw NotFound("Could not find option '"  + parameter + "'." + this->suggest_parameter( parameter ));
+    }
+    
+    return m_options[id];
 }
 
 
+const Option& CmdLineArguments::lookup_name( const std::string& option_name ) const {
+    const uint32_t id = this->option_id( option_name );
+    if ( id == NameIndex::npos ) {
+        throw NotFound("Could not find option '"  + option_name + "'." + this->suggest_name( option_name ));
+    }
+    
+    return this->option_by_id( id );
+}
 
-const Option CmdLineArguments::lookup_option( const std::string parameter ) const {
-    std::string option_str;
-    if ( parameter.compare( 0, 1, "-" ) != 0 ) {
-        throw NotFound("Could not find option '"  + parameter + "'.");
-    } else if ( parameter.compare( 0, 2, "--" ) == 0 ) {
-        option_str = parameter.substr( 2 );
-    } else {
-        option_str = parameter.substr( 1 );
+
+std::string CmdLineArguments::suggest_parameter( const StringView& parameter ) const {
+    std::vector< std::string > specifiers;
+    specifiers.reserve( 2 * m_options.size() );
+    for ( size_t o = 0; o < m_options.size(); o++ ) {
+        specifiers.push_back( "--" + m_options[o].option() );
+        specifiers.push_back( "-" + m_options[o].option_short() );
+    }
+    
+    return Suggestions::did_you_mean( parameter, specifiers );
+}
+
+
+std::string CmdLineArguments::suggest_name( const StringView& option_name ) const {
+    std::vector< std::string > names;
+    names.reserve( m_options.size() + m_positionals.size() );
+    for ( size_t o = 0; o < m_options.size(); o++ ) {
+        names.push_back( m_options[o].option() );
+    }
+    for ( size_t p = 0; p < m_positionals.size(); p++ ) {
+        names.push_back( m_positionals[p].option() );
+    }
+    
+    return Suggestions::did_you_mean( option_name, names );
+}
+
+
+uint32_t CmdLineArguments::option_id( const StringView& option_name ) const {
+    if ( m_frozen ) {
+        return m_name_index.find( option_name.data(), option_name.length() );
+    }
+    
+    for ( uint32_t o = 0; o < m_options.size(); o++ ) {
+        if ( option_name == m_options[o].option() ) {
+            return o;
+        }
+    }
+    for ( uint32_t p = 0; p < m_positionals.size(); p++ ) {
+        if ( option_name == m_positionals[p].option() ) {
+            return static_cast< uint32_t >( m_options.size() ) + p;
+        }
+    }
+    
+    return NameIndex::npos;
+}
+
+
+uint32_t CmdLineArguments::option_id_of_parameter( const StringView& parameter ) const {
+    const StringView option_str = strip_dashes( parameter );
+    if ( option_str.data() == nullptr ) {
+        return NameIndex::npos;
+    }
+    
+    return this->find_regular( option_str );
+}
+
+
+std::pair< const uint32_t*, const uint32_t* > CmdLineArguments::options_with_prefix( const StringView& prefix, bool short_specifier ) const {
+    if ( short_specifier ) {
+        return prefix_range( m_sorted_short, prefix, [this]( uint32_t o ) -> const std::string& {
+            return m_options[o].option_short();
+        } );
+    }
+    return prefix_range( m_sorted_long, prefix, [this]( uint32_t o ) -> const std::string& {
+        return m_options[o].option();
+    } );
+}
+
+
+std::pair< const uint32_t*, const uint32_t* > CmdLineArguments::actions_with_prefix( const StringView& prefix ) const {
+    return prefix_range( m_sorted_actions, prefix, [this]( uint32_t a ) -> const std::string& {
+        return m_actions[a].name();
+    } );
+}
+
+
+const Option& CmdLineArguments::option_by_id( uint32_t id ) const {
+    if ( id < m_options.size() ) {
+        return m_options[id];
     }
     
+    return m_positionals.at( id - m_options.size() );
+}
+
+
+size_t CmdLineArguments::option_count() const {
+    return m_options.size() + m_positionals.size();
+}
+
+
+size_t CmdLineArguments::memory_footprint() const {
+    size_t bytes = sizeof( CmdLineArguments );
+    bytes += m_actions.capacity() * sizeof( Action );
+    bytes += ( m_options.capacity() + m_positionals.capacity() ) * sizeof( Option );
+    for ( size_t a = 0; a < m_actions.size(); a++ ) {
+        bytes += string_heap_bytes( m_actions[a].name() ) + string_heap_bytes( m_actions[a].help_text() );
+    }
+    for ( size_t o = 0; o < this->option_count(); o++ ) {
+        const Option& option = this->option_by_id( static_cast< uint32_t >( o ) );
+        bytes += string_heap_bytes( option.option() ) + string_heap_bytes( option.option_short() );
+        bytes += string_heap_bytes( option.help_text() ) + string_heap_bytes( option.environment_variable() );
+    }
+    
+    const NameIndex* indices[] = { &m_token_index, &m_name_index, &m_action_index, &m_environment_index };
+    for ( size_t i = 0; i < sizeof( indices ) / sizeof( indices[0] ); i++ ) {
+        bytes += indices[i]->slots().capacity() * sizeof( NameIndex::Slot );
+    }
+    bytes += m_defined_names.capacity() * sizeof( uint32_t ) + m_defined_hashes.capacity() * sizeof( uint64_t );
+    bytes += string_heap_bytes( m_environment_prefix ) + string_heap_bytes( m_positional_source );
+    bytes += ( m_sorted_long.capacity() + m_sorted_short.capacity() + m_sorted_actions.capacity() ) * sizeof( uint32_t );
+    
+    return bytes;
+}
+
+
+bool CmdLineArguments::has_environment_variables() const {
+    if ( m_frozen ) {
+        return m_environment_index.size() > 0;
+    }
     
     for ( unsigned int o = 0; o < m_options.size(); o++ ) {
-        Option option = m_options.at( o );
-        
-        if ( option_str.compare( option.option() ) == 0
-          || option_str.compare( option.option_short() ) == 0
+        if ( !m_options[o].environment_variable().empty() ) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+const std::string& CmdLineArguments::environment_prefix() const {
+    return m_environment_prefix;
+}
+
+
+uint32_t CmdLineArguments::option_id_of_environment( const StringView& variable ) const {
+    if ( m_frozen ) {
+        return m_environment_index.find( variable.data(), variable.length() );
+    }
+    
+    for ( uint32_t o = 0; o < m_options.size(); o++ ) {
+        if ( !m_options[o].environment_variable().empty()
+          && variable == m_options[o].environment_variable()
         ) {
-            return option;
+            return o;
         }
     }
+    
+    return NameIndex::npos;
+}
 
-    throw NotFound("Could not find option '"  + parameter + "'.");
+
+void CmdLineArguments::set_positional_source( const std::string& option_name ) {
+    m_positional_source = option_name;
+}
+
+
+uint32_t CmdLineArguments::positional_source_id() const {
+    if ( m_positional_source.empty() ) {
+        return NameIndex::npos;
+    }
+    return this->option_id( m_positional_source );
 }
 
 
 
-std::vector< Option > CmdLineArguments::options_positional() const {
+const std::vector< Option >& CmdLineArguments::options_positional() const {
     return m_positionals;
 }
 
 
-std::vector< Option > CmdLineArguments::options_regular() const {
+const std::vector< Option >& CmdLineArguments::options_regular() const {
     return m_options;
 }
 
 
-std::vector< Action > CmdLineArguments::actions() const {
+const std::vector< Action >& CmdLineArguments::actions() const {
     return m_actions;
 }
 
@@ -26,6 +26,8 @@
 #pragma once
 
 #include "actions.hpp"
+#include "index.hpp"
+#include "stringview.hpp"
 
 #include <stdexcept>
 #include <string>
@@ -46,6 +48,11 @@ namespace cmdlinecpp {
  * @brief Macro that represents the string value "False"
  */
 #define FALSE "False"
+/**
+ * @def END_OF_OPTIONS
+ * @brief Macro that represents the parameter "--", behind which all parameters are positional
+ */
+#define END_OF_OPTIONS "--"
 
 
 /**
@@ -61,15 +68,14 @@ public:
      */
     Data();
     /**
-     * @brief Constructor.
+     * @brief Constructor. Requests the last value given for an option.
      * @param key The name of the option to request
      */
     Data( const std::string key );
     /**
      * @brief Constructor.
      * @param key The name of the option to request
-     * @param appearence The n-th appearence of this option is requested
-     * @warning Not needed at the moment
+     * @param appearence The n-th appearence of this option is requested, starting with 1. 0 requests the last one.
      */
     Data( const std::string key
         , const unsigned int appearence );
@@ -83,10 +89,10 @@ public:
      * @brief Get the name of the requested option
      * @returns The name of the requested option
      */
-    const std::string key() const;
+    const std::string& key() const;
     /**
      * @brief Get the number of the requested occurrence.
-     * @returns A number, not an index
+     * @returns A number, not an index. 0 means the last occurrence.
      */
     const unsigned int appearence() const;
        
@@ -117,7 +123,7 @@ protected:
     /**
      * @brief The pair that defines the option. The first element is the name, the second can be an empty string or a string with one element
      */
-    std::pair< const std::string, const std::string > m_option;
+    std::pair< std::string, std::string > m_option;
     /**
      * @brief The help text for this Option
      */
@@ -126,6 +132,10 @@ protected:
      * @brief The data type this option has as parameter
      */
     Data::Type m_data_type;
+    /**
+     * @brief The name of the environment variable that is used, if the option is not given, or an empty string
+     */
+    std::string m_environment_variable;
     
 public:
     /**
@@ -175,18 +185,32 @@ public:
      * @brief Get the name of this option and the long specifier for regular options
      * @returns The string passed as parameter option_long to the constructor
      */
-    const std::string option() const;
+    const std::string& option() const;
     /**
      * @brief Get the short specifier of this regular option
      * @returns The 1-3 characters passed as parameter option_short to the constructor
      * @warning Returns an empty string on positional argument options
      */
-    const std::string option_short() const;
+    const std::string& option_short() const;
     /**
      * @brief Get the help text
      * @returns The help text
      */
-    const std::string help_text() const;
+    const std::string& help_text() const;
+    /**
+     * @brief Get the environment variable that is used, if this option is not given on the command line
+     * @returns The name of the variable or an empty string
+     */
+    const std::string& environment_variable() const;
+    
+    /**
+     * @brief Use an environment variable, if this regular option is not given on the command line
+     * @param variable The name of the variable, e.g. MYTOOL_THREADS
+     * @returns This option, so it can be passed on directly
+     * @note A Bool option is set, if the variable is not empty and not "0", "false" or "False".
+     * @note Environment variables of positional options are ignored.
+     */
+    Option& from_environment( const std::string& variable );
     
     /**
      * @brief Add a string to the help text.
@@ -201,6 +225,8 @@ public:
  * @brief A class that specifies and holds the required and optional arguments of a command line call to a program
  */
 class CmdLineArguments {
+    friend class SchemaCache;
+    
 protected:
     /**
      * @brief All possible actions
@@ -215,6 +241,96 @@ protected:
      */
     std::vector< Option > m_options;
     
+    /**
+     * @brief True, if the indices below are built and up to date
+     */
+    bool m_frozen;
+    /**
+     * @brief Index over the long and short specifiers of all regular options. The value is the option id.
+     */
+    NameIndex m_token_index;
+    /**
+     * @brief Index over the names of all regular and positional options. The value is the option id.
+     */
+    NameIndex m_name_index;
+    /**
+     * @brief Index over the names of all actions. The value is the position in m_actions.
+     */
+    NameIndex m_action_index;
+    /**
+     * @brief Hash set over the names of all options, that is kept up to date while options are added, so duplicates are found without a scan
+     * @note A slot is 0, if it is empty, or the position in m_options times 2 plus 1, or the position in m_positionals times 2 plus 2.
+     */
+    std::vector< uint32_t > m_defined_names;
+    /**
+     * @brief The hashes of the names in m_defined_names
+     */
+    std::vector< uint64_t > m_defined_hashes;
+    /**
+     * @brief The number of names in m_defined_names
+     */
+    size_t m_defined_count;
+    /**
+     * @brief Index over the environment variables of the regular options. The value is the option id.
+     */
+    NameIndex m_environment_index;
+    /**
+     * @brief The longest prefix all environment variables in m_environment_index share, e.g. MYTOOL_
+     */
+    std::string m_environment_prefix;
+    /**
+     * @brief The name of an option that can supply the last positional list instead of the command line, e.g. files-from
+     */
+    std::string m_positional_source;
+    /**
+     * @brief The ids of the regular options ordered by their long specifier, for the prefix search of the completion
+     */
+    std::vector< uint32_t > m_sorted_long;
+    /**
+     * @brief The ids of the regular options ordered by their short specifier
+     */
+    std::vector< uint32_t > m_sorted_short;
+    /**
+     * @brief The positions of the actions ordered by their name
+     */
+    std::vector< uint32_t > m_sorted_actions;
+    
+    /**
+     * @brief Strip the leading '-' or "--" from a regular option specifier
+     * @param parameter The specifier as passed on the command line
+     * @returns A view on the option string or an empty view on nullptr, if parameter does not begin with '-'
+     */
+    static StringView strip_dashes( const StringView& parameter );
+    /**
+     * @brief Find the id of a regular option by its long or short specifier without dashes
+     * @param option_str The specifier
+     * @returns The option id or NameIndex::npos, if no regular option has this specifier
+     */
+    uint32_t find_regular( const StringView& option_str ) const;
+    /**
+     * @brief Drop the indices, because the definitions changed
+     */
+    void thaw();
+    /**
+     * @brief Get the name of an option in m_defined_names
+     * @param slot The value of the slot
+     * @returns The name of the option
+     */
+    const std::string& defined_name( uint32_t slot ) const;
+    /**
+     * @brief Add a name to m_defined_names and grow it, if it gets more than half full
+     * @param slot The value of the slot for the option
+     */
+    void define_name( uint32_t slot );
+    /**
+     * @brief Rebuild m_defined_names from all definitions, e.g. after the definitions were loaded from a SchemaCache
+     */
+    void rebuild_defined_names();
+    /**
+     * @brief Fill m_sorted_long, m_sorted_short and m_sorted_actions from all definitions
+     */
+    void sort_names();
+    
     /**
      * @brief Add a positional option
      * @param option The option to add
@@ -242,18 +358,37 @@ public:
      */
     void add_action( Action action );
     
+    /**
+     * @brief Test, if an option with a name is defined, in constant time
+     * @param option_name The name of a regular or positional option
+     * @returns True, if an option with this name is defined
+     */
+    bool has_name( const StringView& option_name ) const;
+    
+    /**
+     * @brief Build the lookup indices over all options and actions defined so far
+     * @note After freezing, every lookup is done with one hash probe instead of walking all definitions.
+     * @note Adding an option or action afterwards drops the indices until freeze is called again.
+     */
+    void freeze();
+    /**
+     * @brief Test, if the lookup indices are built
+     * @returns True, if freeze was called and nothing was added since then
+     */
+    bool is_frozen() const;
+    
     /**
      * @brief Look up, if the requested option is regular
      * @param parameter Parameter that can be the long or short option specifier or some string that is not known
      * @returns True, if the option begins with one or two '-' and parameter is specified in one Option that is already specified in this CmdLineArguments
      */
-    bool is_option_regular( const std::string parameter ) const;
+    bool is_option_regular( const StringView& parameter ) const;
     /**
      * @brief Look up, if the requested option is regular
      * @param parameter Name of the positional option or some string that is not known
      * @returns True, if the option does not begin with one '-' and parameter is specified in one Option that is already specified in this CmdLineArguments
      */
-    bool is_option_positional( const std::string parameter ) const;
+    bool is_option_positional( const StringView& parameter ) const;
     /**
      * @brief Test, if actions are enabled
      * @returns True, if actions are enabled
@@ -264,7 +399,7 @@ public:
      * @param parameter Name of the action or some string that is not known
      * @returns True, if the parameter is known as an action.
      */
-    bool is_action( const std::string parameter ) const;
+    bool is_action( const StringView& parameter ) const;
     
     /**
      * @brief Find a positional option by its name
@@ -272,30 +407,125 @@ public:
      * @returns The option found
      * @throws NotFound Only if the option is not found
      */
-    const Option lookup_positional( const std::string option_name ) const;
+    const Option& lookup_positional( const std::string& option_name ) const;
     /**
      * @brief Find a regular option by its name or short option
      * @param parameter The name or short parameter to look for
      * @returns The option found
      * @throws NotFound Only if the option is not found
      */
-    const Option lookup_option( const std::string parameter ) const;
+    const Option& lookup_option( const std::string& parameter ) const;
+    /**
+     * @brief Find a regular or positional option by its name (the long specifier without dashes)
+     * @param option_name The name to look for
+     * @returns The option found
+     * @throws NotFound Only if the option is not found
+     */
+    const Option& lookup_name( const std::string& option_name ) const;
+    /**
+     * @brief Suggest the regular options, whose specifiers are closest to an unknown command line parameter
+     * @param parameter The unknown parameter with its dashes
+     * @returns A sentence like " Did you mean '--iterations'?" to append to an error message, or an empty string
+     * @note Meant for the error path only. It compares the parameter with every specifier.
+     */
+    std::string suggest_parameter( const StringView& parameter ) const;
+    /**
+     * @brief Suggest the regular and positional options, whose names are closest to an unknown name
+     * @param option_name The unknown name
+     * @returns A sentence like " Did you mean 'iterations'?" to append to an error message, or an empty string
+     * @note Meant for the error path only. It compares the name with every name.
+     */
+    std::string suggest_name( const StringView& option_name ) const;
+    
+    /**
+     * @brief Get the id of a regular or positional option by its name
+     * @param option_name The name to look for
+     * @returns The id of the option or NameIndex::npos, if the option is not found
+     * @note Regular options are numbered first in the order they were added, then the positional options follow.
+     */
+    uint32_t option_id( const StringView& option_name ) const;
+    /**
+     * @brief Get the id of a regular option by the specifier passed on the command line
+     * @param parameter The specifier with one or two leading dashes
+     * @returns The id of the option or NameIndex::npos, if parameter is no regular option
+     */
+    uint32_t option_id_of_parameter( const StringView& parameter ) const;
+    /**
+     * @brief Find the regular options whose long or short specifier starts with a prefix
+     * @param prefix The beginning of the specifier without dashes
+     * @param short_specifier True to search the short specifiers, false to search the long ones
+     * @returns The range of the option ids, ordered by the specifier
+     * @warning Only valid, if the arguments are frozen
+     */
+    std::pair< const uint32_t*, const uint32_t* > options_with_prefix( const StringView& prefix, bool short_specifier ) const;
+    /**
+     * @brief Find the actions whose name starts with a prefix
+     * @param prefix The beginning of the name
+     * @returns The range of the positions in actions(), ordered by the name
+     * @warning Only valid, if the arguments are frozen
+     */
+    std::pair< const uint32_t*, const uint32_t* > actions_with_prefix( const StringView& prefix ) const;
+    /**
+     * @brief Get an option by its id
+     * @param id The id of a regular or positional option
+     * @returns The option with this id
+     */
+    const Option& option_by_id( uint32_t id ) const;
+    /**
+     * @brief Get the number of regular and positional options
+     * @returns The number of valid option ids
+     */
+    size_t option_count() const;
+    /**
+     * @brief Estimate the memory the definitions and their indices hold
+     * @returns The number of bytes of this object, its vectors, the index tables and the strings not stored inline
+     */
+    size_t memory_footprint() const;
+    
+    /**
+     * @brief Test, if any regular option has an environment variable as fallback
+     * @returns True, if at least one regular option has an environment variable
+     */
+    bool has_environment_variables() const;
+    /**
+     * @brief Get the prefix all environment variables of the options share
+     * @returns The longest common prefix, e.g. MYTOOL_. Variables without it can be skipped without a lookup.
+     * @warning Only valid, if the arguments are frozen
+     */
+    const std::string& environment_prefix() const;
+    /**
+     * @brief Get the id of the regular option that falls back to an environment variable
+     * @param variable The name of the variable
+     * @returns The option id or NameIndex::npos, if no regular option uses this variable
+     */
+    uint32_t option_id_of_environment( const StringView& variable ) const;
+    
+    /**
+     * @brief Let an option supply the last positional list, e.g. --files-from
+     * @param option_name The name of the option. If it is given, the last positional argument may be missing on the command line.
+     */
+    void set_positional_source( const std::string& option_name );
+    /**
+     * @brief Get the id of the option that can supply the last positional list
+     * @returns The option id or NameIndex::npos, if no such option is set
+     */
+    uint32_t positional_source_id() const;
     
     /**
-     * @brief Get a copy of the vector with all positional options specified
-     * @returns A copy of the vector with all positional options specified
+     * @brief Get the vector with all positional options specified
+     * @returns The vector with all positional options specified
      */
-    std::vector< Option > options_positional() const;
+    const std::vector< Option >& options_positional() const;
     /**
-     * @brief Get a copy of the vector with all regular options specified
-     * @returns A copy of the vector with all regular options specified
+     * @brief Get the vector with all regular options specified
+     * @returns The vector with all regular options specified
      */
-    std::vector< Option > options_regular() const;
+    const std::vector< Option >& options_regular() const;
     /**
      * @brief Get the possible actions that are defined for this command line arguments
      * @returns A list of possible actions
      */
-    std::vector< Action > actions() const;
+    const std::vector< Action >& actions() const;
     
     /**
      * @brief Exception that is to be thrown, when something in this list is not found
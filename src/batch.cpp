@@ -0,0 +1,532 @@
+/**
+ * @file batch.cpp
+ * @brief A file that defines the parsing of many command lines at once
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include <atomic>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "batch.hpp"
+#include "exceptions.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief The chunks of lines one thread works off. Other threads steal from the same counter, when their own chunks are done.
+ */
+struct WorkQueue {
+    std::atomic< size_t > next;
+    size_t end;
+    // Keeps the counters of different threads on different cache lines
+    char padding[64];
+};
+
+
+/**
+ * @brief The first and the number of tokens of a command line read from a file
+ */
+struct TokenRange {
+    size_t first;
+    size_t count;
+};
+
+
+/**
+ * @brief Parse one command line into the arena of the calling thread
+ */
+void parse_line( const CmdLineArguments& arguments
+               , bool unknown_options_rejected
+               , const CommandLine& line
+               , MonotonicArena& arena
+               , CmdLineParameters*& parameters
+               , std::string& error
+               , char& ok
+) {
+    void* memory = arena.allocate( sizeof( CmdLineParameters ), alignof( CmdLineParameters ) );
+    parameters = new ( memory ) CmdLineParameters( &arguments, &arena );
+
+    try {
+        parameters->reserve( line.argc );
+        Parser::parse_parameters( arguments, line.argv, line.argc, *parameters, unknown_options_rejected );
+        parameters->finish();
+        ok = 1;
+    } catch ( std::exception& e ) {
+        error = e.what();
+    } catch ( ... ) {
+        error = "Unknown error.";
+    }
+}
+
+
+/**
+ * @brief Map a whole file privately, so the tokens can point into it and JSON strings can be unescaped in place
+ */
+void map_file( const std::string& path, std::unique_ptr< MappedFile >& file ) {
+    file.reset( new MappedFile() );
+    try {
+        if ( !file->open( path ) ) {
+            throw std::runtime_error("Could not open '" + path + "'.");
+        }
+    } catch ( exceptions::ResponseFileError& ) {
+        throw std::runtime_error("Could not read '" + path + "'.");
+    }
+}
+
+
+/**
+ * @brief Read 4 hexadecimal digits of a \\u escape
+ * @returns False, if there are no 4 hexadecimal digits
+ */
+bool read_hex4( const char*& p, const char* end, unsigned int& code ) {
+    if ( end - p < 4 ) {
+        return false;
+    }
+    code = 0;
+    for ( int d = 0; d < 4; d++, p++ ) {
+        const char c = *p;
+        code <<= 4;
+        if ( c >= '0' && c <= '9' ) {
+            code |= c - '0';
+        } else if ( c >= 'a' && c <= 'f' ) {
+            code |= c - 'a' + 10;
+        } else if ( c >= 'A' && c <= 'F' ) {
+            code |= c - 'A' + 10;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Write a code point as UTF-8. It is never longer than the escape it was read from.
+ */
+void write_utf8( char*& w, unsigned int code ) {
+    if ( code < 0x80 ) {
+        *w++ = static_cast< char >( code );
+    } else if ( code < 0x800 ) {
+        *w++ = static_cast< char >( 0xc0 | ( code >> 6 ) );
+        *w++ = static_cast< char >( 0x80 | ( code & 0x3f ) );
+    } else if ( code < 0x10000 ) {
+        *w++ = static_cast< char >( 0xe0 | ( code >> 12 ) );
+        *w++ = static_cast< char >( 0x80 | ( ( code >> 6 ) & 0x3f ) );
+        *w++ = static_cast< char >( 0x80 | ( code & 0x3f ) );
+    } else {
+        *w++ = static_cast< char >( 0xf0 | ( code >> 18 ) );
+        *w++ = static_cast< char >( 0x80 | ( ( code >> 12 ) & 0x3f ) );
+        *w++ = static_cast< char >( 0x80 | ( ( code >> 6 ) & 0x3f ) );
+        *w++ = static_cast< char >( 0x80 | ( code & 0x3f ) );
+    }
+}
+
+
+/**
+ * @brief Read a JSON string in place. The unescaped string is written over the escaped one, as it is never longer.
+ * @param p Points behind the opening quote and is moved behind the closing quote
+ * @returns False on a syntax error
+ */
+bool read_json_string( char*& p, const char* end, StringView& token ) {
+    char* const begin = p;
+    char* w = p;
+    while ( p != end ) {
+        const char c = *p++;
+        if ( c == '"' ) {
+            token = StringView( begin, w - begin );
+            return true;
+        }
+        if ( static_cast< unsigned char >( c ) < 0x20 ) {
+            return false;
+        }
+        if ( c != '\\' ) {
+            *w++ = c;
+            continue;
+        }
+
+        if ( p == end ) {
+            return false;
+        }
+        switch ( *p++ ) {
+            case '"': *w++ = '"'; break;
+            case '\\': *w++ = '\\'; break;
+            case '/': *w++ = '/'; break;
+            case 'b': *w++ = '\b'; break;
+            case 'f': *w++ = '\f'; break;
+            case 'n': *w++ = '\n'; break;
+            case 'r': *w++ = '\r'; break;
+            case 't': *w++ = '\t'; break;
+            case 'u': {
+                const char* q = p;
+                unsigned int code = 0;
+                if ( !read_hex4( q, end, code ) ) {
+                    return false;
+                }
+                if ( code >= 0xd800 && code < 0xdc00 ) {
+                    // A surrogate pair is written as two escapes
+                    unsigned int low = 0;
+                    if ( end - q < 2 || q[0] != '\\' || q[1] != 'u' ) {
+                        return false;
+                    }
+                    q += 2;
+                    if ( !read_hex4( q, end, low ) || low < 0xdc00 || low >= 0xe000 ) {
+                        return false;
+                    }
+                    code = 0x10000 + ( ( code - 0xd800 ) << 10 ) + ( low - 0xdc00 );
+                } else if ( code >= 0xdc00 && code < 0xe000 ) {
+                    return false;
+                }
+                p += q - p;
+                write_utf8( w, code );
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+
+bool is_json_space( char c ) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+
+/**
+ * @brief Read one line with a JSON array of strings
+ * @returns False on a syntax error
+ */
+bool read_json_line( char* p, const char* end, std::vector< StringView >& tokens ) {
+    while ( p != end && is_json_space( *p ) ) ++p;
+    if ( p == end || *p++ != '[' ) {
+        return false;
+    }
+    while ( p != end && is_json_space( *p ) ) ++p;
+    if ( p != end && *p == ']' ) {
+        ++p;
+    } else {
+        while ( true ) {
+            while ( p != end && is_json_space( *p ) ) ++p;
+            if ( p == end || *p++ != '"' ) {
+                return false;
+            }
+            StringView token;
+            if ( !read_json_string( p, end, token ) ) {
+                return false;
+            }
+            tokens.push_back( token );
+
+            while ( p != end && is_json_space( *p ) ) ++p;
+            if ( p == end ) {
+                return false;
+            }
+            const char c = *p++;
+            if ( c == ']' ) {
+                break;
+            }
+            if ( c != ',' ) {
+                return false;
+            }
+        }
+    }
+    while ( p != end && is_json_space( *p ) ) ++p;
+    return p == end;
+}
+
+
+/**
+ * @brief Make the command lines, after all tokens are read and do not move anymore
+ */
+std::vector< CommandLine > make_lines( const std::vector< StringView >& tokens, const std::vector< TokenRange >& ranges ) {
+    std::vector< CommandLine > lines;
+    lines.reserve( ranges.size() );
+    for ( size_t l = 0; l < ranges.size(); l++ ) {
+        CommandLine line = { tokens.data() + ranges[l].first, ranges[l].count };
+        lines.push_back( line );
+    }
+    return lines;
+}
+
+} // namespace
+
+
+BatchResults::BatchResults()
+    :   m_file()
+    ,   m_tokens()
+    ,   m_arenas()
+    ,   m_parameters()
+    ,   m_errors()
+    ,   m_ok()
+{}
+
+
+BatchResults& BatchResults::operator=( BatchResults&& other ) {
+    if ( this != &other ) {
+        // The parameters live in the arenas and have to be destroyed before the arenas are replaced
+        this->destroy_parameters();
+        m_file = std::move( other.m_file );
+        m_tokens = std::move( other.m_tokens );
+        m_arenas = std::move( other.m_arenas );
+        m_parameters = std::move( other.m_parameters );
+        m_errors = std::move( other.m_errors );
+        m_ok = std::move( other.m_ok );
+        other.m_parameters.clear();
+    }
+    return *this;
+}
+
+
+BatchResults::~BatchResults() {
+    this->destroy_parameters();
+}
+
+
+void BatchResults::destroy_parameters() {
+    for ( size_t l = 0; l < m_parameters.size(); l++ ) {
+        if ( m_parameters[l] != nullptr ) {
+            m_parameters[l]->~CmdLineParameters();
+        }
+    }
+    m_parameters.clear();
+}
+
+
+size_t BatchResults::size() const {
+    return m_ok.size();
+}
+
+
+size_t BatchResults::count_ok() const {
+    size_t count = 0;
+    for ( size_t l = 0; l < m_ok.size(); l++ ) {
+        count += m_ok[l];
+    }
+    return count;
+}
+
+
+bool BatchResults::ok( size_t line ) const {
+    return m_ok.at( line ) != 0;
+}
+
+
+const std::string& BatchResults::error( size_t line ) const {
+    return m_errors.at( line );
+}
+
+
+const CmdLineParameters& BatchResults::parameters( size_t line ) const {
+    if ( !this->ok( line ) ) {
+        throw std::out_of_range("The command line failed: " + m_errors[line]);
+    }
+    return *m_parameters[line];
+}
+
+
+BatchParser::BatchParser( Parser& parser, unsigned int threads )
+    :   m_arguments( parser.arguments() )
+    ,   m_unknown_options_rejected( parser.unknown_options_rejected() )
+    ,   m_threads( threads )
+{
+    if ( m_threads == 0 ) {
+        m_threads = std::thread::hardware_concurrency();
+    }
+    if ( m_threads == 0 ) {
+        m_threads = 1;
+    }
+}
+
+
+unsigned int BatchParser::threads() const {
+    return m_threads;
+}
+
+
+void BatchParser::parse_into( const CommandLine* lines, size_t count, BatchResults& results ) const {
+    // Errors of reading the lines are already set
+    results.m_errors.resize( count );
+    results.m_parameters.assign( count, nullptr );
+    results.m_ok.assign( count, 0 );
+    if ( count == 0 ) {
+        return;
+    }
+
+    size_t chunk = count / ( static_cast< size_t >( m_threads ) * 8 );
+    if ( chunk == 0 ) {
+        chunk = 1;
+    } else if ( chunk > 1024 ) {
+        chunk = 1024;
+    }
+    size_t threads = m_threads;
+    if ( threads > ( count + chunk - 1 ) / chunk ) {
+        threads = ( count + chunk - 1 ) / chunk;
+    }
+
+    std::unique_ptr< WorkQueue[] > queues( new WorkQueue[threads] );
+    for ( size_t t = 0; t < threads; t++ ) {
+        queues[t].next.store( count * t / threads );
+        queues[t].end = count * ( t + 1 ) / threads;
+    }
+
+    results.m_arenas.clear();
+    for ( size_t t = 0; t < threads; t++ ) {
+        results.m_arenas.push_back( std::unique_ptr< MonotonicArena >( new MonotonicArena() ) );
+    }
+
+    const CmdLineArguments& arguments = m_arguments;
+    const bool unknown_options_rejected = m_unknown_options_rejected;
+    BatchResults& out = results;
+    WorkQueue* const queue = queues.get();
+    auto work = [ &arguments, unknown_options_rejected, &out, queue, threads, chunk, lines ]( size_t self ) {
+        MonotonicArena& arena = *out.m_arenas[self];
+        // Own chunks first, then the chunks of the others
+        for ( size_t v = 0; v < threads; v++ ) {
+            WorkQueue& victim = queue[ ( self + v ) % threads ];
+            while ( true ) {
+                const size_t first = victim.next.fetch_add( chunk );
+                if ( first >= victim.end ) {
+                    break;
+                }
+                const size_t last = first + chunk < victim.end ? first + chunk : victim.end;
+                for ( size_t l = first; l < last; l++ ) {
+                    if ( !out.m_errors[l].empty() ) {
+                        continue;
+                    }
+                    parse_line( arguments, unknown_options_rejected, lines[l], arena, out.m_parameters[l], out.m_errors[l], out.m_ok[l] );
+                }
+            }
+        }
+    };
+
+    std::vector< std::thread > workers;
+    workers.reserve( threads - 1 );
+    for ( size_t t = 1; t < threads; t++ ) {
+        workers.push_back( std::thread( work, t ) );
+    }
+    work( 0 );
+    for ( size_t t = 0; t < workers.size(); t++ ) {
+        workers[t].join();
+    }
+}
+
+
+BatchResults BatchParser::parse( const CommandLine* lines, size_t count ) const {
+    BatchResults results;
+    this->parse_into( lines, count, results );
+    return results;
+}
+
+
+BatchResults BatchParser::parse( const std::vector< std::vector< StringView > >& lines ) const {
+    std::vector< CommandLine > command_lines;
+    command_lines.reserve( lines.size() );
+    for ( size_t l = 0; l < lines.size(); l++ ) {
+        CommandLine line = { lines[l].data(), lines[l].size() };
+        command_lines.push_back( line );
+    }
+
+    return this->parse( command_lines.data(), command_lines.size() );
+}
+
+
+BatchResults BatchParser::parse_ndjson_file( const std::string& path ) const {
+    BatchResults results;
+    map_file( path, results.m_file );
+
+    std::vector< TokenRange > ranges;
+    char* p = results.m_file->data();
+    char* const end = p + results.m_file->size();
+    size_t line_number = 0;
+    while ( p < end ) {
+        ++line_number;
+        char* eol = p;
+        while ( eol != end && *eol != '\n' ) ++eol;
+
+        char* q = p;
+        while ( q != eol && is_json_space( *q ) ) ++q;
+        if ( q != eol ) {
+            TokenRange range = { results.m_tokens.size(), 0 };
+            if ( read_json_line( q, eol, results.m_tokens ) ) {
+                range.count = results.m_tokens.size() - range.first;
+                results.m_errors.push_back( std::string() );
+            } else {
+                results.m_tokens.resize( range.first );
+                results.m_errors.push_back( "Line " + std::to_string( line_number ) + " is no JSON array of strings." );
+            }
+            ranges.push_back( range );
+        }
+
+        p = eol + 1;
+    }
+
+    const std::vector< CommandLine > lines = make_lines( results.m_tokens, ranges );
+    this->parse_into( lines.data(), lines.size(), results );
+    return results;
+}
+
+
+BatchResults BatchParser::parse_nul_separated_file( const std::string& path ) const {
+    BatchResults results;
+    map_file( path, results.m_file );
+
+    std::vector< TokenRange > ranges;
+    const char* p = results.m_file->data();
+    const char* const end = p + results.m_file->size();
+    TokenRange range = { 0, 0 };
+    while ( p < end ) {
+        if ( *p == '\n' ) {
+            // A newline where a parameter would start ends the command line
+            if ( range.count > 0 ) {
+                ranges.push_back( range );
+            }
+            range.first = results.m_tokens.size();
+            range.count = 0;
+            ++p;
+            continue;
+        }
+
+        const char* nul = p;
+        while ( nul != end && *nul != '\0' ) ++nul;
+        results.m_tokens.push_back( StringView( p, nul - p ) );
+        ++range.count;
+        p = nul + 1;
+    }
+    if ( range.count > 0 ) {
+        ranges.push_back( range );
+    }
+
+    results.m_errors.resize( ranges.size() );
+    const std::vector< CommandLine > lines = make_lines( results.m_tokens, ranges );
+    this->parse_into( lines.data(), lines.size(), results );
+    return results;
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,213 @@
+/**
+ * @file batch.hpp
+ * @brief A file that defines the parsing of many command lines at once
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arena.hpp"
+#include "cmdline.hpp"
+#include "parameters.hpp"
+#include "responsefile.hpp"
+#include "stringview.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief A non-owning view on one command line, like the argc and argv parameters of a main function
+ */
+struct CommandLine {
+    /**
+     * @brief The parameters. The first one is the program name.
+     */
+    const StringView* argv;
+    /**
+     * @brief The number of parameters
+     */
+    size_t argc;
+};
+
+
+/**
+ * @brief The results of parsing many command lines with a BatchParser, one per command line in input order
+ */
+class BatchResults {
+    friend class BatchParser;
+
+    /**
+     * @brief The input file, if the command lines were read from a file. It is mapped privately and the tokens point into it.
+     */
+    std::unique_ptr< MappedFile > m_file;
+    /**
+     * @brief The parameters of all command lines read from a file
+     */
+    std::vector< StringView > m_tokens;
+    /**
+     * @brief One arena per worker thread. The parameters of the command lines a worker parsed live in its arena.
+     */
+    std::vector< std::unique_ptr< MonotonicArena > > m_arenas;
+    /**
+     * @brief The parsed parameters of every command line or nullptr, if the command line could not be read
+     */
+    std::vector< CmdLineParameters* > m_parameters;
+    /**
+     * @brief The error message of every command line, that failed
+     */
+    std::vector< std::string > m_errors;
+    /**
+     * @brief True for every command line that was parsed without error
+     */
+    std::vector< char > m_ok;
+
+    /**
+     * @brief Destroy the parameters in the arenas, so the arenas can be freed or replaced
+     */
+    void destroy_parameters();
+
+public:
+    BatchResults();
+    BatchResults( BatchResults&& other ) = default;
+    /**
+     * @brief Move assignment. Destroys the parameters held so far.
+     */
+    BatchResults& operator=( BatchResults&& other );
+    /**
+     * @brief Destructor. Gives back the memory of all parameters.
+     */
+    ~BatchResults();
+
+    /**
+     * @brief Get the number of command lines
+     * @returns The number of command lines
+     */
+    size_t size() const;
+    /**
+     * @brief Get the number of command lines that were parsed without error
+     * @returns The number of command lines, that were parsed successfully
+     */
+    size_t count_ok() const;
+    /**
+     * @brief Test, if a command line was parsed without error
+     * @param line The index of the command line
+     * @returns True, if the command line was parsed successfully
+     */
+    bool ok( size_t line ) const;
+    /**
+     * @brief Get the reason a command line failed
+     * @param line The index of the command line
+     * @returns The error message or an empty string, if the command line was parsed successfully
+     */
+    const std::string& error( size_t line ) const;
+    /**
+     * @brief Get the parsed values of a command line
+     * @param line The index of the command line
+     * @returns The parameters with typed values, e.g. for CmdLineParameters::value and CmdLineParameters::occurrences
+     * @throws std::out_of_range If the command line failed
+     */
+    const CmdLineParameters& parameters( size_t line ) const;
+};
+
+
+/**
+ * @brief Parses many command lines against the options of one Parser on several threads
+ *
+ * The lines are split into chunks. Every thread works off its own chunks first and then steals
+ * chunks from the other threads, so uneven lines do not leave threads idle. All threads read the
+ * same frozen CmdLineArguments. Nothing is locked while parsing.
+ */
+class BatchParser {
+    /**
+     * @brief The frozen definitions all command lines are parsed against
+     */
+    const CmdLineArguments& m_arguments;
+    /**
+     * @brief True, if the parser rejects unknown options in place of positional arguments
+     */
+    bool m_unknown_options_rejected;
+    /**
+     * @brief The number of threads to parse with
+     */
+    unsigned int m_threads;
+
+    /**
+     * @brief Parse the lines into results, that may already hold the storage the lines point into
+     * @param lines The command lines
+     * @param count The number of command lines
+     * @param results The results to fill
+     */
+    void parse_into( const CommandLine* lines, size_t count, BatchResults& results ) const;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param parser The parser that defines the options. Its definitions are frozen and must not be changed while the BatchParser is used.
+     *        Its setting of Parser::set_unknown_options_rejected is taken over.
+     * @param threads The number of threads. 0 uses one thread per core.
+     */
+    explicit BatchParser( Parser& parser, unsigned int threads = 0 );
+
+    /**
+     * @brief Get the number of threads that parse
+     * @returns The number of threads
+     */
+    unsigned int threads() const;
+
+    /**
+     * @brief Parse many command lines
+     * @param lines The command lines. The viewed characters have to outlive the results.
+     * @param count The number of command lines
+     * @returns The results in the order of lines
+     */
+    BatchResults parse( const CommandLine* lines, size_t count ) const;
+    /**
+     * @brief Parse many command lines
+     * @param lines The command lines, one vector of parameters per line. They have to outlive the results.
+     * @returns The results in the order of lines
+     */
+    BatchResults parse( const std::vector< std::vector< StringView > >& lines ) const;
+    /**
+     * @brief Parse a file with one JSON array of strings per line, e.g. ["prog", "-n", "3"]
+     * @param path The path of the file
+     * @returns The results in the order of the non-empty lines of the file. A line that is no array of strings fails.
+     * @throws std::runtime_error If the file can not be read
+     * @note The file is mapped privately and the parameters point into it, nothing is copied.
+     */
+    BatchResults parse_ndjson_file( const std::string& path ) const;
+    /**
+     * @brief Parse a file where every parameter ends with a NUL character and every command line ends with a newline behind its last NUL
+     * @param path The path of the file
+     * @returns The results in the order of the command lines of the file
+     * @throws std::runtime_error If the file can not be read
+     * @note The file is mapped privately and the parameters point into it, nothing is copied.
+     */
+    BatchResults parse_nul_separated_file( const std::string& path ) const;
+};
+
+
+} // namespace cmdlinecpp
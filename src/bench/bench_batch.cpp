@@ -0,0 +1,133 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "batch.hpp"
+#include "cmdline.hpp"
+#include "convert.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Reports the throughput of the batch parser in lines per second for 1 to N threads.
+
+namespace {
+
+/**
+ * @brief Make random job command lines. Every tenth one has an invalid number.
+ */
+void make_lines( size_t count, std::vector< std::string >& storage, std::vector< std::vector< cmdlinecpp::StringView > >& lines ) {
+    std::mt19937 random( 42 );
+    std::uniform_int_distribution< int > number( 0, 100000 );
+    std::uniform_int_distribution< int > includes( 0, 4 );
+
+    std::vector< std::vector< size_t > > indices( count );
+    for ( size_t l = 0; l < count; l++ ) {
+        indices[l].push_back( storage.size() );
+        storage.push_back( "job" );
+        indices[l].push_back( storage.size() );
+        storage.push_back( "--iterations" );
+        indices[l].push_back( storage.size() );
+        storage.push_back( l % 10 == 9 ? "many" : std::to_string( number( random ) ) );
+        for ( int i = includes( random ); i > 0; i-- ) {
+            indices[l].push_back( storage.size() );
+            storage.push_back( "-I" );
+            indices[l].push_back( storage.size() );
+            storage.push_back( "/usr/include/path" + std::to_string( i ) );
+        }
+        indices[l].push_back( storage.size() );
+        storage.push_back( "-v" );
+        indices[l].push_back( storage.size() );
+        storage.push_back( "/var/jobs/input" + std::to_string( l ) + ".dat" );
+    }
+
+    // The views are made after storage stops growing
+    lines.resize( count );
+    for ( size_t l = 0; l < count; l++ ) {
+        for ( size_t t = 0; t < indices[l].size(); t++ ) {
+            lines[l].push_back( storage[ indices[l][t] ] );
+        }
+    }
+}
+
+} // namespace
+
+
+int main( int argc, char** argv ) {
+    size_t count = 200000;
+    unsigned int max_threads = std::thread::hardware_concurrency();
+    if ( argc > 1 ) {
+        count = cmdlinecpp::convert::to_unsigned_long( argv[1] );
+    }
+    if ( argc > 2 ) {
+        max_threads = cmdlinecpp::convert::to_unsigned_int( argv[2] );
+    }
+    if ( max_threads == 0 ) {
+        max_threads = 1;
+    }
+
+    cmdlinecpp::Parser parser;
+    parser << cmdlinecpp::Option( "iterations", "n", "The number of iterations.", cmdlinecpp::Data::Type::Int );
+    parser << cmdlinecpp::Option( "include", "I", "A directory to include.", cmdlinecpp::Data::Type::String );
+    parser << cmdlinecpp::Option( "verbose", "v", "Print more.", cmdlinecpp::Data::Type::Bool );
+    parser << cmdlinecpp::Option( "INPUT", "The input file." );
+
+    std::vector< std::string > storage;
+    std::vector< std::vector< cmdlinecpp::StringView > > lines;
+    make_lines( count, storage, lines );
+
+    std::cout << "Parsing " << count << " command lines" << std::endl;
+    std::cout << std::setw( 8 ) << "threads"
+              << std::setw( 16 ) << "lines/s"
+              << std::setw( 10 ) << "speedup"
+              << std::setw( 10 ) << "failed" << std::endl;
+
+    bool ok = true;
+    double single = 0;
+    for ( unsigned int threads = 1; threads <= max_threads; threads++ ) {
+        cmdlinecpp::BatchParser batch( parser, threads );
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        cmdlinecpp::BatchResults results = batch.parse( lines );
+        std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+
+        const double rate = count / elapsed.count();
+        if ( threads == 1 ) {
+            single = rate;
+        }
+        const size_t failed = results.size() - results.count_ok();
+        ok = ok && failed == count / 10;
+
+        std::cout << std::setw( 8 ) << threads
+                  << std::setw( 16 ) << std::fixed << std::setprecision( 0 ) << rate
+                  << std::setw( 9 ) << std::setprecision( 2 ) << rate / single << "x"
+                  << std::setw( 10 ) << failed << std::endl;
+    }
+
+    return ok ? 0 : 1;
+}
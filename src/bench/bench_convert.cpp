@@ -0,0 +1,157 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "convert.hpp"
+#include "exceptions.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// Compares the integer conversion kernel with the istringstream path, that was used before.
+
+namespace {
+
+volatile long sink = 0;
+
+
+template< typename T >
+std::vector< std::string > make_inputs( size_t count ) {
+    std::mt19937_64 random( 42 );
+    std::uniform_int_distribution< long long > distribution( std::numeric_limits< T >::min(), std::numeric_limits< T >::max() );
+    
+    std::vector< std::string > inputs;
+    inputs.reserve( count );
+    for ( size_t i = 0; i < count; i++ ) {
+        std::ostringstream ostring;
+        ostring << static_cast< T >( distribution( random ) );
+        inputs.push_back( ostring.str() );
+    }
+    return inputs;
+}
+
+
+template< typename T >
+double run_stream( const std::vector< std::string >& inputs, unsigned int rounds ) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( unsigned int r = 0; r < rounds; r++ ) {
+        for ( size_t i = 0; i < inputs.size(); i++ ) {
+            T value = 0;
+            std::istringstream istring( inputs[i] );
+            istring >> value;
+            sink += static_cast< long >( value );
+        }
+    }
+    std::chrono::duration< double, std::nano > elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ( static_cast< double >( inputs.size() ) * rounds );
+}
+
+
+template< typename T >
+double run_kernel( const std::vector< std::string >& inputs, unsigned int rounds, T (*convert)( const cmdlinecpp::StringView& ) ) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( unsigned int r = 0; r < rounds; r++ ) {
+        for ( size_t i = 0; i < inputs.size(); i++ ) {
+            sink += static_cast< long >( convert( inputs[i] ) );
+        }
+    }
+    std::chrono::duration< double, std::nano > elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ( static_cast< double >( inputs.size() ) * rounds );
+}
+
+
+template< typename T >
+bool bench( const char* type_name, T (*convert)( const cmdlinecpp::StringView& ), size_t count, unsigned int rounds ) {
+    const std::vector< std::string > inputs = make_inputs< T >( count );
+    
+    // Both paths have to agree on valid input
+    for ( size_t i = 0; i < inputs.size(); i++ ) {
+        T expected = 0;
+        std::istringstream istring( inputs[i] );
+        istring >> expected;
+        if ( convert( inputs[i] ) != expected ) {
+            std::cerr << "MISMATCH for " << type_name << ": '" << inputs[i] << "'" << std::endl;
+            return false;
+        }
+    }
+    
+    const double stream_ns = run_stream< T >( inputs, rounds );
+    const double kernel_ns = run_kernel< T >( inputs, rounds, convert );
+    
+    std::cout << std::left << std::setw( 16 ) << type_name
+              << std::right << std::fixed << std::setprecision( 2 )
+              << std::setw( 14 ) << stream_ns
+              << std::setw( 14 ) << kernel_ns
+              << std::setw( 10 ) << stream_ns / kernel_ns << "x" << std::endl;
+    return true;
+}
+
+} // namespace
+
+
+int main( int argc, char** argv ) {
+    size_t count = 100000;
+    unsigned int rounds = 10;
+    if ( argc > 1 ) {
+        count = cmdlinecpp::convert::to_unsigned_long( argv[1] );
+    }
+    if ( argc > 2 ) {
+        rounds = cmdlinecpp::convert::to_unsigned_int( argv[2] );
+    }
+    
+    std::cout << "Converting " << count << " values " << rounds << " times per type (ns per value)" << std::endl;
+    std::cout << std::left << std::setw( 16 ) << "type"
+              << std::right << std::setw( 14 ) << "istringstream"
+              << std::setw( 14 ) << "kernel"
+              << std::setw( 11 ) << "speedup" << std::endl;
+    
+    bool ok = true;
+    ok = bench< long >( "long", &cmdlinecpp::convert::to_long, count, rounds ) && ok;
+    ok = bench< int >( "int", &cmdlinecpp::convert::to_int, count, rounds ) && ok;
+    ok = bench< short >( "short", &cmdlinecpp::convert::to_short, count, rounds ) && ok;
+    ok = bench< unsigned long >( "unsigned long", &cmdlinecpp::convert::to_unsigned_long, count, rounds ) && ok;
+    ok = bench< unsigned int >( "unsigned int", &cmdlinecpp::convert::to_unsigned_int, count, rounds ) && ok;
+    ok = bench< unsigned short >( "unsigned short", &cmdlinecpp::convert::to_unsigned_short, count, rounds ) && ok;
+    
+    // The stream path silently clamps an overflow, the kernel reports it
+    std::istringstream istring( "99999999999" );
+    int clamped = 0;
+    istring >> clamped;
+    std::cout << std::endl << "istringstream reads '99999999999' into int as " << clamped << std::endl;
+    try {
+        cmdlinecpp::convert::to_int( "99999999999" );
+        std::cout << "kernel accepted '99999999999' as int" << std::endl;
+        ok = false;
+    } catch ( cmdlinecpp::exceptions::TypeError& te ) {
+        std::cout << "kernel: " << te.what() << std::endl;
+    }
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,314 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "cmdline.hpp"
+#include "convert.hpp"
+#include "exceptions.hpp"
+#include "synthetic.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// Reports how the parser scales with the size of the schema and of the command line:
+// the time to define and freeze a schema, the fixed cost of a parse, the time per further
+// parameter and the allocations per parse. The fixed cost is the time to parse the smallest valid
+// command line, an action and the two positional arguments. ns/token is the time above it divided
+// by the other parameters.
+// Usage: cmdlinecpp_bench [max options] [file for the results as JSON lines]
+
+namespace {
+
+const char* const usage = "Usage: cmdlinecpp_bench [max options] [file for the results as JSON lines]";
+
+// The parameters of the smallest valid synthetic command line
+const size_t fixed_tokens = 3;
+
+size_t allocations = 0;
+size_t allocated_bytes = 0;
+
+
+/**
+ * @brief Count the allocations and bytes since construction
+ */
+class AllocationCounter {
+    size_t m_allocations;
+    size_t m_bytes;
+
+public:
+    AllocationCounter()
+        :   m_allocations( allocations )
+        ,   m_bytes( allocated_bytes )
+    {}
+
+    size_t count() const {
+        return allocations - m_allocations;
+    }
+
+    size_t bytes() const {
+        return allocated_bytes - m_bytes;
+    }
+};
+
+
+void* counted_allocation( std::size_t size ) {
+    ++allocations;
+    allocated_bytes += size;
+    void* memory = std::malloc( size > 0 ? size : 1 );
+    if ( memory == nullptr ) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+
+struct Result {
+    size_t options;
+    const char* argv_size;
+    size_t tokens;
+    double build_ms;
+    size_t build_allocations;
+    double fixed_us;
+    double parse_us;
+    double ns_per_token;
+    double allocations_per_parse;
+    double bytes_per_parse;
+};
+
+
+/**
+ * @brief Define a synthetic schema and freeze it
+ * @returns The time in milliseconds
+ */
+double build_schema( size_t options, size_t& build_allocations ) {
+    const unsigned int rounds = options >= 10000 ? 3 : 20;
+    double total = 0;
+    for ( unsigned int r = 0; r < rounds; r++ ) {
+        AllocationCounter counter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        {
+            cmdlinecpp::Parser parser;
+            bench::define_synthetic_schema( parser, options );
+            parser.arguments();
+            std::chrono::duration< double, std::milli > elapsed = std::chrono::steady_clock::now() - start;
+            total += elapsed.count();
+        }
+        build_allocations = counter.count();
+    }
+    return total / rounds;
+}
+
+
+/**
+ * @brief Parse a command line repeatedly with one parser
+ * @param rounds Set to the number of parses
+ * @returns The mean time of a parse in nanoseconds
+ */
+double time_parse( cmdlinecpp::Parser& parser, int argc, char** argv, unsigned int& rounds ) {
+    rounds = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::duration< double, std::nano > elapsed( 0 );
+    while ( rounds < 5 || elapsed.count() < 2e8 ) {
+        parser.parse( argc, argv );
+        ++rounds;
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    return elapsed.count() / rounds;
+}
+
+
+/**
+ * @brief Measure the fixed cost of a parse: the time to parse the smallest valid command line
+ * @returns The mean time of a parse in microseconds
+ */
+double bench_fixed_cost( cmdlinecpp::Parser& parser ) {
+    const char* parameters[fixed_tokens + 2] = { "synthetic", "action-0", "/srv/data/output.dat", "/srv/data/input-0.dat", nullptr };
+    const int argc = static_cast< int >( fixed_tokens + 1 );
+    char** argv = const_cast< char** >( parameters );
+    parser.parse( argc, argv );
+
+    unsigned int rounds = 0;
+    return time_parse( parser, argc, argv, rounds ) / 1000.0;
+}
+
+
+/**
+ * @brief Parse a synthetic command line repeatedly with one parser
+ * @note result.fixed_us has to be set, ns_per_token is the time above it per further parameter.
+ */
+void bench_parse( cmdlinecpp::Parser& parser, bench::SyntheticArgv& argv, Result& result ) {
+    // The first parse freezes the schema and grows the arena, later parses reuse both
+    parser.parse( argv.argc(), argv.argv() );
+
+    unsigned int rounds = 0;
+    AllocationCounter counter;
+    const double parse_ns = time_parse( parser, argv.argc(), argv.argv(), rounds );
+
+    result.tokens = static_cast< size_t >( argv.argc() - 1 );
+    result.parse_us = parse_ns / 1000.0;
+    const double variable_ns = parse_ns - result.fixed_us * 1000.0;
+    result.ns_per_token = ( result.tokens > fixed_tokens && variable_ns > 0 ) ? variable_ns / ( result.tokens - fixed_tokens ) : 0;
+    result.allocations_per_parse = static_cast< double >( counter.count() ) / rounds;
+    result.bytes_per_parse = static_cast< double >( counter.bytes() ) / rounds;
+}
+
+
+void print_json( std::ostream& out, const Result& result ) {
+    out << std::fixed << std::setprecision( 3 )
+        << "{\"options\": " << result.options
+        << ", \"argv\": \"" << result.argv_size << "\""
+        << ", \"tokens\": " << result.tokens
+        << ", \"build_ms\": " << result.build_ms
+        << ", \"build_allocations\": " << result.build_allocations
+        << ", \"fixed_us\": " << result.fixed_us
+        << ", \"parse_us\": " << result.parse_us
+        << ", \"ns_per_token\": " << result.ns_per_token
+        << ", \"allocations_per_parse\": " << result.allocations_per_parse
+        << ", \"bytes_per_parse\": " << result.bytes_per_parse
+        << "}" << std::endl;
+}
+
+} // namespace
+
+
+void* operator new( std::size_t size ) {
+    return counted_allocation( size );
+}
+
+
+void* operator new[]( std::size_t size ) {
+    return counted_allocation( size );
+}
+
+
+void operator delete( void* memory ) noexcept {
+    std::free( memory );
+}
+
+
+void operator delete[]( void* memory ) noexcept {
+    std::free( memory );
+}
+
+
+void operator delete( void* memory, std::size_t ) noexcept {
+    std::free( memory );
+}
+
+
+void operator delete[]( void* memory, std::size_t ) noexcept {
+    std::free( memory );
+}
+
+
+int main( int argc, char** argv ) {
+    size_t max_options = 50000;
+    std::ofstream json;
+    if ( argc > 1 ) {
+        const std::string first( argv[1] );
+        if ( first == "-h" || first == "--help" ) {
+            std::cout << usage << std::endl;
+            return 0;
+        }
+        try {
+            max_options = cmdlinecpp::convert::to_unsigned_long( argv[1] );
+        } catch ( cmdlinecpp::exceptions::TypeError& te ) {
+            std::cerr << "ERROR: " << te.what() << std::endl << usage << std::endl;
+            return 1;
+        }
+    }
+    if ( argc > 2 ) {
+        json.open( argv[2] );
+        if ( !json ) {
+            std::cerr << "Could not open '" << argv[2] << "'." << std::endl;
+            return 1;
+        }
+    }
+
+    const size_t schema_sizes[] = { 10, 100, 1000, 10000, 50000 };
+    const bench::ArgvSize argv_sizes[] = { bench::ArgvSize::Short, bench::ArgvSize::Typical, bench::ArgvSize::ArgMax };
+
+    std::cout << std::setw( 8 ) << "options"
+              << std::setw( 10 ) << "argv"
+              << std::setw( 10 ) << "tokens"
+              << std::setw( 12 ) << "build ms"
+              << std::setw( 14 ) << "build allocs"
+              << std::setw( 12 ) << "fixed us"
+              << std::setw( 14 ) << "parse us"
+              << std::setw( 10 ) << "ns/token"
+              << std::setw( 14 ) << "allocs/parse" << std::endl;
+
+    try {
+        for ( size_t s = 0; s < sizeof( schema_sizes ) / sizeof( schema_sizes[0] ) && schema_sizes[s] <= max_options; s++ ) {
+            const size_t options = schema_sizes[s];
+            size_t build_allocations = 0;
+            const double build_ms = build_schema( options, build_allocations );
+
+            cmdlinecpp::Parser parser;
+            bench::define_synthetic_schema( parser, options );
+            const double fixed_us = bench_fixed_cost( parser );
+
+            for ( size_t a = 0; a < sizeof( argv_sizes ) / sizeof( argv_sizes[0] ); a++ ) {
+                bench::SyntheticArgv synthetic( options, argv_sizes[a] );
+
+                Result result;
+                result.options = options;
+                result.argv_size = bench::argv_size_name( argv_sizes[a] );
+                result.build_ms = build_ms;
+                result.build_allocations = build_allocations;
+                result.fixed_us = fixed_us;
+                bench_parse( parser, synthetic, result );
+
+                std::cout << std::setw( 8 ) << result.options
+                          << std::setw( 10 ) << result.argv_size
+                          << std::setw( 10 ) << result.tokens
+                          << std::fixed << std::setprecision( 3 )
+                          << std::setw( 12 ) << result.build_ms
+                          << std::setw( 14 ) << result.build_allocations
+                          << std::setw( 12 ) << result.fixed_us
+                          << std::setw( 14 ) << result.parse_us
+                          << std::setprecision( 1 )
+                          << std::setw( 10 ) << result.ns_per_token
+                          << std::setw( 14 ) << result.allocations_per_parse << std::endl;
+                if ( json.is_open() ) {
+                    print_json( json, result );
+                }
+            }
+        }
+    } catch ( std::out_of_range& oor ) {
+        std::cerr << "ERROR: " << oor.what() << std::endl;
+        return 1;
+    } catch ( cmdlinecpp::exceptions::TypeError& te ) {
+        std::cerr << "ERROR: " << te.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
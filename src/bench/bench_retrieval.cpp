@@ -0,0 +1,225 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+
+#include "config.hpp"
+
+#include "cmdline.hpp"
+#include "convert.hpp"
+#include "parameters.hpp"
+#include "synthetic.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Measures how expensive it is to read a parsed value again and again, per data type:
+// the lookup of the name, the conversion of the text (done once while parsing), to_variable,
+// the operator>> chain with a new or a kept Data object, and a direct read by option id.
+// Usage: cmdlinecpp_bench_retrieval [options in the schema] [reads per measurement]
+
+namespace {
+
+volatile long sink = 0;
+
+
+template< typename T >
+struct Retrieval;
+
+template<> struct Retrieval< bool > {
+    static long read( const cmdlinecpp::Value& value ) { return value.as_bool; }
+    static long use( const bool& value ) { return value; }
+};
+template<> struct Retrieval< double > {
+    static long read( const cmdlinecpp::Value& value ) { return static_cast< long >( value.as_double ); }
+    static long use( const double& value ) { return static_cast< long >( value ); }
+};
+template<> struct Retrieval< long > {
+    static long read( const cmdlinecpp::Value& value ) { return value.as_long; }
+    static long use( const long& value ) { return value; }
+};
+template<> struct Retrieval< int > {
+    static long read( const cmdlinecpp::Value& value ) { return value.as_int; }
+    static long use( const int& value ) { return value; }
+};
+template<> struct Retrieval< short > {
+    static long read( const cmdlinecpp::Value& value ) { return value.as_short; }
+    static long use( const short& value ) { return value; }
+};
+template<> struct Retrieval< std::string > {
+    static long read( const cmdlinecpp::Value& value ) { return static_cast< long >( value.text.length() ); }
+    static long use( const std::string& value ) { return static_cast< long >( value.length() ); }
+};
+template<> struct Retrieval< unsigned long > {
+    static long read( const cmdlinecpp::Value& value ) { return static_cast< long >( value.as_unsigned_long ); }
+    static long use( const unsigned long& value ) { return static_cast< long >( value ); }
+};
+template<> struct Retrieval< unsigned int > {
+    static long read( const cmdlinecpp::Value& value ) { return value.as_unsigned_int; }
+    static long use( const unsigned int& value ) { return value; }
+};
+template<> struct Retrieval< unsigned short > {
+    static long read( const cmdlinecpp::Value& value ) { return value.as_unsigned_short; }
+    static long use( const unsigned short& value ) { return value; }
+};
+
+
+/**
+ * @brief Run a measurement and get the time per read in nanoseconds
+ */
+template< typename F >
+double measure( size_t reads, F read ) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( size_t r = 0; r < reads; r++ ) {
+        read();
+    }
+    std::chrono::duration< double, std::nano > elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / reads;
+}
+
+
+/**
+ * @brief The parsed synthetic command line with one option of every data type
+ */
+struct Fixture {
+    cmdlinecpp::Parser& parser;
+    const cmdlinecpp::CmdLineParameters& parameters;
+    size_t reads;
+};
+
+
+template< typename T >
+void bench_type( const char* type_name, size_t option, const Fixture& fixture ) {
+    cmdlinecpp::Parser& parser = fixture.parser;
+    const cmdlinecpp::CmdLineArguments& arguments = parser.arguments();
+    const std::string key = bench::synthetic_name( option );
+    const cmdlinecpp::StringView key_view( key );
+    const uint32_t id = arguments.option_id( key_view );
+    const cmdlinecpp::Data::Type data_type = arguments.option_by_id( id ).dataType();
+    const cmdlinecpp::StringView text = fixture.parameters.value( id ).text;
+    const cmdlinecpp::Data data( key );
+
+    const double lookup = measure( fixture.reads, [&]() {
+        sink += arguments.option_id( key_view );
+    } );
+    const double conversion = measure( fixture.reads, [&]() {
+        sink += Retrieval< T >::read( cmdlinecpp::Value::from_text( data_type, text ) );
+    } );
+    const double to_variable = measure( fixture.reads, [&]() {
+        T value = T();
+        parser.to_variable( key, value );
+        sink += Retrieval< T >::use( value );
+    } );
+    const double stream_new = measure( fixture.reads, [&]() {
+        T value = T();
+        parser >> cmdlinecpp::Data( key ) >> value;
+        sink += Retrieval< T >::use( value );
+    } );
+    const double stream_kept = measure( fixture.reads, [&]() {
+        T value = T();
+        parser >> data >> value;
+        sink += Retrieval< T >::use( value );
+    } );
+    const double by_id = measure( fixture.reads, [&]() {
+        sink += Retrieval< T >::read( fixture.parameters.value( id ) );
+    } );
+
+    std::cout << std::left << std::setw( 16 ) << type_name
+              << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 10 ) << lookup
+              << std::setw( 10 ) << conversion
+              << std::setw( 13 ) << to_variable
+              << std::setw( 13 ) << stream_new
+              << std::setw( 13 ) << stream_kept
+              << std::setw( 10 ) << by_id << std::endl;
+}
+
+} // namespace
+
+
+int main( int argc, char** argv ) {
+    size_t options = 1000;
+    size_t reads = 1000000;
+    if ( argc > 1 ) {
+        options = cmdlinecpp::convert::to_unsigned_long( argv[1] );
+    }
+    if ( argc > 2 ) {
+        reads = cmdlinecpp::convert::to_unsigned_long( argv[2] );
+    }
+    if ( options < bench::synthetic_type_count ) {
+        options = bench::synthetic_type_count;
+    }
+
+    cmdlinecpp::Parser parser;
+    bench::define_synthetic_schema( parser, options );
+
+    // One option of every data type, the synthetic types repeat in the order of synthetic_types
+    std::mt19937 random( 42 );
+    std::vector< std::string > storage;
+    storage.push_back( "synthetic" );
+    for ( size_t o = 0; o < bench::synthetic_type_count; o++ ) {
+        storage.push_back( "--" + bench::synthetic_name( o ) );
+        if ( bench::synthetic_type( o ) != cmdlinecpp::Data::Type::Bool ) {
+            storage.push_back( bench::synthetic_value( o, random ) );
+        }
+    }
+    storage.push_back( "/srv/data/output.dat" );
+    storage.push_back( "/srv/data/input.dat" );
+    std::vector< char* > synthetic_argv;
+    for ( size_t s = 0; s < storage.size(); s++ ) {
+        synthetic_argv.push_back( &storage[s][0] );
+    }
+    parser.parse( static_cast< int >( synthetic_argv.size() ), synthetic_argv.data() );
+
+    // The same command line parsed into parameters of its own, so they can be read by id
+    std::vector< cmdlinecpp::StringView > views( storage.begin(), storage.end() );
+    const cmdlinecpp::CmdLineArguments& arguments = parser.arguments();
+    cmdlinecpp::CmdLineParameters parameters( &arguments );
+    parameters.reserve( views.size() );
+    cmdlinecpp::Parser::parse_parameters( arguments, views.data(), views.size(), parameters );
+    parameters.finish();
+
+    const Fixture fixture = { parser, parameters, reads };
+
+    std::cout << "Reading every value " << reads << " times from a schema of " << options << " options (ns per read)" << std::endl;
+    std::cout << std::left << std::setw( 16 ) << "type"
+              << std::right << std::setw( 10 ) << "lookup"
+              << std::setw( 10 ) << "convert"
+              << std::setw( 13 ) << "to_variable"
+              << std::setw( 13 ) << ">> Data()"
+              << std::setw( 13 ) << ">> kept"
+              << std::setw( 10 ) << "by id" << std::endl;
+
+    bench_type< bool >( "bool", 0, fixture );
+    bench_type< int >( "int", 1, fixture );
+    bench_type< std::string >( "std::string", 2, fixture );
+    bench_type< double >( "double", 3, fixture );
+    bench_type< long >( "long", 4, fixture );
+    bench_type< short >( "short", 5, fixture );
+    bench_type< unsigned long >( "unsigned long", 6, fixture );
+    bench_type< unsigned int >( "unsigned int", 7, fixture );
+    bench_type< unsigned short >( "unsigned short", 8, fixture );
+
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * @file synthetic.hpp
+ * @brief A file that generates synthetic option schemas and command lines for the benchmarks
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+#include "cmdline.hpp"
+
+
+namespace bench {
+
+
+/**
+ * @brief The data types of the synthetic options, that are used in turn
+ */
+const cmdlinecpp::Data::Type synthetic_types[] = {
+    cmdlinecpp::Data::Type::Bool,
+    cmdlinecpp::Data::Type::Int,
+    cmdlinecpp::Data::Type::String,
+    cmdlinecpp::Data::Type::Double,
+    cmdlinecpp::Data::Type::Long,
+    cmdlinecpp::Data::Type::Short,
+    cmdlinecpp::Data::Type::UnsignedLong,
+    cmdlinecpp::Data::Type::UnsignedInt,
+    cmdlinecpp::Data::Type::UnsignedShort
+};
+const size_t synthetic_type_count = sizeof( synthetic_types ) / sizeof( synthetic_types[0] );
+
+
+/**
+ * @brief Get the long name of the synthetic option with an index
+ */
+inline std::string synthetic_name( size_t index ) {
+    return "option-" + std::to_string( index );
+}
+
+
+/**
+ * @brief Get the short specifier of the synthetic option with an index, one to three letters or digits
+ * @note "h" is skipped, because it belongs to the help option.
+ */
+inline std::string synthetic_short( size_t index ) {
+    static const char alphabet[] = "abcdefgijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    const size_t base = sizeof( alphabet ) - 1;
+    std::string result;
+    size_t rest = index;
+    do {
+        result += alphabet[ rest % base ];
+        rest /= base;
+    } while ( rest > 0 && result.length() < 3 );
+    if ( rest > 0 ) {
+        return std::string();
+    }
+    return result;
+}
+
+
+/**
+ * @brief Get the data type of the synthetic option with an index
+ */
+inline cmdlinecpp::Data::Type synthetic_type( size_t index ) {
+    return synthetic_types[ index % synthetic_type_count ];
+}
+
+
+/**
+ * @brief Get a valid value for the synthetic option with an index
+ */
+inline std::string synthetic_value( size_t index, std::mt19937& random ) {
+    switch ( synthetic_type( index ) ) {
+        case cmdlinecpp::Data::Type::Int:
+        case cmdlinecpp::Data::Type::Long:
+            return std::to_string( static_cast< int >( random() % 200000 ) - 100000 );
+        case cmdlinecpp::Data::Type::Short:
+            return std::to_string( static_cast< int >( random() % 60000 ) - 30000 );
+        case cmdlinecpp::Data::Type::UnsignedLong:
+        case cmdlinecpp::Data::Type::UnsignedInt:
+            return std::to_string( random() % 4000000 );
+        case cmdlinecpp::Data::Type::UnsignedShort:
+            return std::to_string( random() % 60000 );
+        case cmdlinecpp::Data::Type::Double:
+            return std::to_string( random() % 100000 ) + "." + std::to_string( random() % 1000 );
+        default:
+            return "/srv/data/input-" + std::to_string( random() % 100000 ) + ".dat";
+    }
+}
+
+
+/**
+ * @brief Define a synthetic schema: regular options of all types, some actions and two positional arguments
+ * @param parser The parser to define the schema in
+ * @param options The number of regular options
+ * @note The last positional argument INPUTS takes the remaining parameters as list.
+ */
+inline void define_synthetic_schema( cmdlinecpp::Parser& parser, size_t options ) {
+    for ( size_t a = 0; a < 8; a++ ) {
+        parser << cmdlinecpp::Action( "action-" + std::to_string( a ), "A synthetic action." );
+    }
+    for ( size_t o = 0; o < options; o++ ) {
+        const std::string short_name = synthetic_short( o );
+        if ( short_name.empty() ) {
+            parser << cmdlinecpp::Option( synthetic_name( o ), "A synthetic option.", synthetic_type( o ) );
+        } else {
+            parser << cmdlinecpp::Option( synthetic_name( o ), short_name, "A synthetic option.", synthetic_type( o ) );
+        }
+    }
+    parser << cmdlinecpp::Option( "OUTPUT", "The synthetic output." );
+    parser << cmdlinecpp::Option( "INPUTS", "The synthetic inputs." );
+}
+
+
+/**
+ * @brief The sizes of the synthetic command lines
+ */
+enum class ArgvSize {
+    /// An action, two options and the positional arguments
+    Short,
+    /// An action, about twenty options in long and short form and a few inputs
+    Typical,
+    /// As many options and inputs as fit into ARG_MAX
+    ArgMax
+};
+
+
+/**
+ * @brief Get the name of a command line size for reports
+ */
+inline const char* argv_size_name( ArgvSize size ) {
+    switch ( size ) {
+        case ArgvSize::Short:
+            return "short";
+        case ArgvSize::Typical:
+            return "typical";
+        default:
+            return "argmax";
+    }
+}
+
+
+/**
+ * @brief Get the size limit of the arguments and environment of a new process
+ */
+inline size_t argument_bytes_max() {
+#ifdef __unix__
+    const long arg_max = sysconf( _SC_ARG_MAX );
+    if ( arg_max > 0 ) {
+        return static_cast< size_t >( arg_max );
+    }
+#endif
+    return 32 * 1024;
+}
+
+
+/**
+ * @brief A synthetic command line, that owns its parameters
+ */
+class SyntheticArgv {
+    std::vector< std::string > m_storage;
+    std::vector< char* > m_argv;
+
+    /**
+     * @brief Add one option with a value, if it takes one, in long or short form
+     * @returns The number of bytes the parameters take in a real argv
+     */
+    size_t add_option( size_t index, std::mt19937& random ) {
+        const std::string short_name = synthetic_short( index );
+        const size_t before = m_storage.size();
+        if ( short_name.empty() || random() % 2 == 0 ) {
+            m_storage.push_back( "--" + synthetic_name( index ) );
+        } else {
+            m_storage.push_back( "-" + short_name );
+        }
+        if ( synthetic_type( index ) != cmdlinecpp::Data::Type::Bool ) {
+            m_storage.push_back( synthetic_value( index, random ) );
+        }
+
+        size_t bytes = 0;
+        for ( size_t s = before; s < m_storage.size(); s++ ) {
+            bytes += m_storage[s].size() + 1 + sizeof( char* );
+        }
+        return bytes;
+    }
+
+public:
+    /**
+     * @brief Constructor. Generates a command line for a synthetic schema.
+     * @param options The number of regular options in the schema
+     * @param size The size of the command line
+     * @param seed The seed of the random generator, so runs are comparable
+     */
+    SyntheticArgv( size_t options, ArgvSize size, unsigned int seed = 42 ) {
+        std::mt19937 random( seed );
+        m_storage.push_back( "synthetic" );
+        m_storage.push_back( "action-" + std::to_string( random() % 8 ) );
+        const size_t budget = argument_bytes_max() / 2;
+        size_t bytes = 0;
+
+        if ( size == ArgvSize::Short ) {
+            this->add_option( 0, random );
+            this->add_option( 1 % options, random );
+        } else if ( size == ArgvSize::Typical ) {
+            for ( size_t o = 0; o < 20; o++ ) {
+                this->add_option( random() % options, random );
+            }
+        } else {
+            // Half of the space for options, the other half for inputs, with room left for the environment
+            while ( bytes < budget / 2 ) {
+                bytes += this->add_option( random() % options, random );
+            }
+        }
+
+        m_storage.push_back( "/srv/data/output.dat" );
+        const size_t inputs = ( size == ArgvSize::Short ) ? 1 : 4;
+        for ( size_t i = 0; i < inputs || ( size == ArgvSize::ArgMax && bytes < budget ); i++ ) {
+            m_storage.push_back( "/srv/data/input-" + std::to_string( i ) + ".dat" );
+            bytes += m_storage.back().size() + 1 + sizeof( char* );
+        }
+
+        // The pointers are taken after the storage stops growing
+        for ( size_t s = 0; s < m_storage.size(); s++ ) {
+            m_argv.push_back( &m_storage[s][0] );
+        }
+        m_argv.push_back( nullptr );
+    }
+
+    /**
+     * @brief Get the number of parameters including the program name
+     */
+    int argc() const {
+        return static_cast< int >( m_storage.size() );
+    }
+
+    /**
+     * @brief Get the parameters like main gets them
+     */
+    char** argv() {
+        return m_argv.data();
+    }
+};
+
+
+} // namespace bench
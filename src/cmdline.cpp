@@ -23,159 +23,470 @@
     USA
 */
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <new>
 #include <stdexcept>
-#include <sstream>
+#include <vector>
 
 #include "cmdline.hpp"
+#include "convert.hpp"
 #include "exceptions.hpp"
 
+#ifdef __unix__
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
 
 namespace cmdlinecpp {
 
-std::unique_ptr< CmdLineInterface > CmdLineInterface::ms_cmdlineparser;
 
+namespace {
 
-CmdLineInterface::CmdLineInterface()
-    :   m_cmdline_arguments( new CmdLineArguments() )
+/**
+ * @brief Get the environment of the process
+ * @returns The list of "NAME=value" strings that ends with nullptr
+ */
+char* const* process_environment() {
+#ifdef __unix__
+    return environ;
+#else
+    return _environ;
+#endif
+}
+
+
+#ifdef CMDLINECPP_PARSE_STATS
+
+/**
+ * @brief Adds the time since the last lap to a phase of ParseStats
+ */
+class PhaseClock {
+    ParseStats* m_stats;
+    std::chrono::steady_clock::time_point m_last;
+
+public:
+    explicit PhaseClock( ParseStats* stats )
+        :   m_stats( stats )
+        ,   m_last()
+    {
+        if ( m_stats != nullptr ) {
+            m_last = std::chrono::steady_clock::now();
+        }
+    }
+
+    void lap( uint64_t ParseStats::* phase ) {
+        if ( m_stats != nullptr ) {
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            m_stats->*phase += static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( now - m_last ).count() );
+            m_last = now;
+        }
+    }
+};
+
+#else
+
+/**
+ * @brief Does nothing, the collection of ParseStats is compiled out
+ */
+class PhaseClock {
+public:
+    explicit PhaseClock( ParseStats* ) {}
+
+    void lap( uint64_t ParseStats::* ) {}
+};
+
+#endif
+
+
+/**
+ * @brief Write a text to stdout in one piece
+ */
+void write_stdout( const std::string& text ) {
+    // Text already written with std::cout has to come first
+    std::cout.flush();
+#ifdef __unix__
+    size_t written = 0;
+    while ( written < text.size() ) {
+        const ssize_t bytes = write( STDOUT_FILENO, text.data() + written, text.size() - written );
+        if ( bytes < 0 && errno == EINTR ) {
+            continue;
+        }
+        if ( bytes <= 0 ) {
+            break;
+        }
+        written += static_cast< size_t >( bytes );
+    }
+#else
+    std::cout.write( text.data(), text.size() );
+    std::cout.flush();
+#endif
+}
+
+} // namespace
+
+
+Parser::Parser()
+    :   m_current_option_requested()
+    ,   m_cmdline_arguments( new CmdLineArguments() )
     ,   m_argc( 0 )
     ,   m_argv()
-    ,   m_cmdline_parameters( new CmdLineParameters() )
-    ,   m_current_option_requested( *new Data() )
+    ,   m_completion_requests_enabled( false )
+    ,   m_completion_requested( false )
+    ,   m_response_files_enabled( false )
+    ,   m_unknown_options_rejected( false )
+    ,   m_response_files()
+    ,   m_expanded_argv()
+    ,   m_config_path()
+    ,   m_config_file()
+    ,   m_snapshot_file()
+    ,   m_arena( new MonotonicArena() )
+    ,   m_cmdline_parameters( nullptr )
+    ,   m_parameters_reusable( false )
     ,   m_program_name()
     ,   m_program_description()
     ,   m_program_version()
     ,   m_usage_examples()
+    ,   m_help()
+    ,   m_parse_stats_enabled( false )
+    ,   m_parse_stats()
 {
+    this->create_parameters( nullptr );
     *this << Option( "help", "h", "Print the help for this program", Data::Type::Bool );
 }
 
 
-CmdLineInterface& CmdLineInterface::get() {
+Parser::~Parser() {
+    this->destroy_parameters();
+}
+
+
+void Parser::create_parameters( const CmdLineArguments* cl_args ) {
+    m_parameters_reusable = false;
+    void* memory = m_arena->allocate( sizeof( CmdLineParameters ), alignof( CmdLineParameters ) );
+    if ( cl_args == nullptr ) {
+        m_cmdline_parameters = new ( memory ) CmdLineParameters( m_arena.get() );
+    } else {
+        m_cmdline_parameters = new ( memory ) CmdLineParameters( cl_args, m_arena.get() );
+    }
+}
+
 
-    if( !ms_cmdlineparser ) {
-        ms_cmdlineparser.reset( new CmdLineInterface() );
+void Parser::destroy_parameters() {
+    if ( m_cmdline_parameters != nullptr ) {
+        m_cmdline_parameters->~CmdLineParameters();
+        m_cmdline_parameters = nullptr;
     }
+}
+
+
+void Parser::set_response_files_enabled( bool enabled ) {
+    m_response_files_enabled = enabled;
+}
+
 
-    return *ms_cmdlineparser;
+void Parser::set_completion_requests_enabled( bool enabled ) {
+    m_completion_requests_enabled = enabled;
 }
 
 
-void CmdLineInterface::define_option( Option option ) {
+void Parser::set_unknown_options_rejected( bool rejected ) {
+    m_unknown_options_rejected = rejected;
+}
+
+
+bool Parser::unknown_options_rejected() const {
+    return m_unknown_options_rejected;
+}
+
+
+bool Parser::completion_requested() const {
+    return m_completion_requested;
+}
+
+
+void Parser::set_config_file( const std::string& path ) {
+    m_config_path = path;
+}
+
+
+void Parser::reset() {
+    this->destroy_parameters();
+    m_arena->release();
+    m_response_files.clear();
+    m_config_file.reset();
+    m_snapshot_file.reset();
+    this->create_parameters( nullptr );
+}
+
+
+void Parser::use_memory_resource( MemoryResource* upstream ) {
+    this->destroy_parameters();
+    m_arena.reset( new MonotonicArena( upstream ) );
+    this->create_parameters( nullptr );
+}
+
+
+CmdLineInterface::CmdLineInterface()
+    :   Parser()
+{
+    // The singleton parses the command line of this process, which the shell completion runs
+    // and whose user may name any file anyway
+    this->set_completion_requests_enabled( true );
+    this->set_response_files_enabled( true );
+}
+
+
+CmdLineInterface& CmdLineInterface::get() {
+    // The initialization of a local static is thread safe since C++11
+    static CmdLineInterface cmdlineparser;
+
+    return cmdlineparser;
+}
+
+
+void Parser::define_option( Option option ) {
     *this << option;
 }
 
 
-void CmdLineInterface::define_action( Action action ) {
+void Parser::define_action( Action action ) {
     *this << action;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator<<( Action action ) {
+Parser& Parser::operator<<( Action action ) {
     m_cmdline_arguments->add_action( action );
+    m_help.clear();
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator<<( Option option ) {
-    bool found_option = false;
-    for ( unsigned int o = 0; o < m_cmdline_arguments->options_regular().size(); o++ ) {
-        Option option_existing = m_cmdline_arguments->options_regular().at( o );
-        if ( option.option().compare( option_existing.option() ) == 0 ) {
-            found_option = true;
-            break;
-        }
-    }
-    
-    bool found_positional = false;
-    for ( unsigned int p = 0; p < m_cmdline_arguments->options_positional().size(); p++ ) {
-        if ( option.option().compare( m_cmdline_arguments->options_positional().at( p ).option() ) == 0 ) {
-            found_positional = true;
-            break;
-        }
-    }
-    
-    if ( !found_option && !found_positional ) {
-        m_cmdline_arguments->add_option( option );
+Parser& Parser::operator<<( Option option ) {
+    // Options with a name that is already defined are ignored
+    if ( !m_cmdline_arguments->has_name( option.option() ) ) {
+        m_cmdline_arguments->add_option( std::move( option ) );
+        m_help.clear();
     }
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator<<( int argc ) {
+Parser& Parser::operator<<( int argc ) {
     m_argc = argc;
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator<<( char** argv ) {
+Parser& Parser::operator<<( char** argv ) {
     if ( m_argc == 0 ) {
         throw std::out_of_range("You need to define a size integer with argc before defining argv.");
     }
     
+    m_argv.clear();
+    m_argv.reserve( m_argc );
     for ( unsigned int a = 0; a < m_argc; a++ ) {
-        std::string argument( argv[a] );
-        m_argv.push_back( argument );
+        m_argv.push_back( StringView( argv[a] ) );
     }
     
     return *this;
 }
 
 
-bool CmdLineInterface::parse() {
+bool Parser::parse() {
     if ( m_argv.size() == 0 ) {
         std::cerr << "No parameters to parse." << std::endl;
         return false;
+    }
+    
+    m_parse_stats = ParseStats();
+    ParseStats* stats = nullptr;
+#ifdef CMDLINECPP_PARSE_STATS
+    const uint64_t probes = NameIndex::probes();
+    if ( m_parse_stats_enabled ) {
+        stats = &m_parse_stats;
+        stats->collected = true;
+    }
+#endif
+    PhaseClock whole( stats );
+    PhaseClock clock( stats );
+    
+    m_cmdline_arguments->freeze();
+    clock.lap( &ParseStats::freeze_ns );
+    
+    m_completion_requested = m_completion_requests_enabled && m_argv.size() >= 3 && m_argv[1] == COMPLETION_REQUEST;
+    if ( m_completion_requested ) {
+        this->answer_completion_request();
+        return false;
+    }
+    
+    m_response_files.clear();
+    m_config_file.reset();
+    m_snapshot_file.reset();
+#ifdef CMDLINECPP_PARSE_STATS
+    size_t allocations_before = m_arena->allocations();
+    size_t used_before = m_arena->used();
+#endif
+    // The slots of the last parse with the same definitions are reset, not built again, so a parse
+    // costs nothing for the options that are not given
+    if ( m_parameters_reusable && m_cmdline_parameters->size() == m_cmdline_arguments->option_count() ) {
+        m_cmdline_parameters->reset();
     } else {
-        m_cmdline_parameters = new CmdLineParameters( m_cmdline_arguments );
+        this->destroy_parameters();
+        m_arena->release();
+        this->create_parameters( m_cmdline_arguments.get() );
+        m_parameters_reusable = true;
+#ifdef CMDLINECPP_PARSE_STATS
+        allocations_before = 0;
+        used_before = 0;
+#endif
+    }
+    
+    const StringView* argv = m_argv.data();
+    size_t argc = m_argv.size();
+    if ( m_response_files_enabled
+      && m_response_files.expand( m_argv.data(), m_argv.size(), m_expanded_argv )
+    ) {
+        argv = m_expanded_argv.data();
+        argc = m_expanded_argv.size();
+    }
+    clock.lap( &ParseStats::tokenize_ns );
+    
+    m_cmdline_parameters->reserve( argc );
+    Parser::parse_parameters( *m_cmdline_arguments, argv, argc, *m_cmdline_parameters, m_unknown_options_rejected, stats );
+    
+    // The fallbacks count as validation, they fill what the command line left out
+    PhaseClock fallbacks( stats );
+    if ( m_cmdline_arguments->has_environment_variables() ) {
+        Parser::parse_environment( *m_cmdline_arguments, process_environment(), *m_cmdline_parameters );
+    }
+    if ( !m_config_path.empty() ) {
+        // The file is mapped again on every parse, so changes to it are seen
+        std::unique_ptr< MappedFile > config_file( new MappedFile() );
+        if ( config_file->open( m_config_path ) ) {
+            m_config_file = std::move( config_file );
+            Parser::parse_config( *m_cmdline_arguments, m_config_file->data(), m_config_file->size(), *m_cmdline_parameters );
+        }
     }
+    m_cmdline_parameters->finish();
+    fallbacks.lap( &ParseStats::validate_ns );
+    whole.lap( &ParseStats::total_ns );
+    
+#ifdef CMDLINECPP_PARSE_STATS
+    if ( stats != nullptr ) {
+        stats->tokens = argc - 1;
+        stats->lookup_probes = NameIndex::probes() - probes;
+        stats->allocations = m_arena->allocations() - allocations_before;
+        stats->allocated_bytes = m_arena->used() - used_before;
+        stats->schema_bytes = m_cmdline_arguments->memory_footprint();
+        stats->parameter_bytes = m_arena->capacity();
+    }
+#endif
+
+    return true;
+}
+
+
+void Parser::parse_parameters( const CmdLineArguments& arguments
+                             , const StringView* argv
+                             , size_t argc
+                             , CmdLineParameters& parameters
+                             , bool unknown_options_rejected
+                             , ParseStats* stats
+) {
+    const std::vector< Option >& positionals = arguments.options_positional();
+    PhaseClock clock( stats );
+    const uint32_t first_positional_id = static_cast< uint32_t >( arguments.options_regular().size() );
     
     unsigned int options_regular = 0;
     unsigned int options_positional = 0;
     unsigned int a = 1;
-    while ( a < m_argv.size() ) {
-        std::string argument = m_argv.at( a );
-        if ( m_cmdline_arguments->is_option_regular( argument ) ) {
+    while ( a < argc ) {
+        const StringView argument = argv[a];
+        if ( argument == END_OF_OPTIONS ) {
+            // Everything behind -- is positional. The last positional list takes the rest as one slice.
+            ++a;
+            while ( a < argc && options_positional < positionals.size() ) {
+                clock.lap( &ParseStats::classify_ns );
+                parameters.set( first_positional_id + options_positional, argv[a] );
+                clock.lap( &ParseStats::convert_ns );
+                ++options_positional;
+                
+                if ( options_positional == positionals.size() ) {
+                    parameters.set_last_positionals( argv + a, argv + argc );
+                    a = argc;
+                } else {
+                    ++a;
+                }
+            }
+            if ( a < argc ) {
+                throw std::out_of_range("Too many positional arguments.");
+            }
+            break;
+        }
+        
+        const uint32_t option_id = arguments.option_id_of_parameter( argument );
+        if ( option_id != NameIndex::npos ) {
             // Is regular option
             ++options_regular;
             
-            Option option = m_cmdline_arguments->lookup_option( argument );
+            const Option& option = arguments.option_by_id( option_id );
             
             if ( option.dataType() != Data::Type::Bool ) {
-                if ( a+1 == m_argv.size() ) {
-                    throw std::out_of_range("The data type of '" + argument + "' is not bool, but there are no more parameters to parse.");
+                if ( a+1 == argc ) {
+                    throw std::out_of_range("The data type of '" + argument.str() + "' is not bool, but there are no more parameters to parse.");
                 } else {
-                    m_cmdline_parameters->set( option.option(), m_argv.at(a+1) );
+                    clock.lap( &ParseStats::classify_ns );
+                    parameters.set( option_id, argv[a+1] );
+                    clock.lap( &ParseStats::convert_ns );
                     a += 2;
                 }
             } else {
-                m_cmdline_parameters->set( option.option(), TRUE );
+                parameters.set( option_id, TRUE );
                 ++a;
             }
             
-        } else if ( m_cmdline_arguments->are_actions_enabled()
-                 && m_cmdline_arguments->is_action( argument )
+        } else if ( arguments.are_actions_enabled()
+                 && arguments.is_action( argument )
         ) {
-            m_cmdline_parameters->set_action( argument );
+            parameters.set_action( argument );
             ++a;
         } else {
             // Is positional option
-            Option option = m_cmdline_arguments->options_positional().at( options_positional );
-                
-            m_cmdline_parameters->set( option.option(), argument );
-            ++options_positional;
-            
-            if ( options_positional >= m_cmdline_arguments->options_positional().size() - 1
-              && m_argv.size() > a + 1
+            const bool dashed = argument.length() > 1 && argument[0] == '-';
+            if ( dashed && unknown_options_rejected
+              && !std::isdigit( static_cast< unsigned char >( argument[1] ) ) && argument[1] != '.'
             ) {
-                std::vector< std::string > last_positionals;
-                for ( unsigned int p = a; p < m_argv.size(); p++ ) {
-                    last_positionals.push_back( m_argv.at( p ) );
+                // Most likely a mistyped option, a lone "-" and negative numbers stay positional
+                throw std::out_of_range("Unknown option '" + argument.str() + "'." + arguments.suggest_parameter( argument ));
+            }
+            if ( options_positional >= positionals.size() ) {
+                if ( dashed ) {
+                    // Most likely a mistyped option
+                    throw std::out_of_range("Unknown option '" + argument.str() + "'." + arguments.suggest_parameter( argument ));
                 }
-                
-                m_cmdline_parameters->set_last_positionals( last_positionals );
+                throw std::out_of_range("Too many positional arguments.");
+            }
+            
+            clock.lap( &ParseStats::classify_ns );
+            parameters.set( first_positional_id + options_positional, argument );
+            clock.lap( &ParseStats::convert_ns );
+            ++options_positional;
+            
+            if ( options_positional == positionals.size() ) {
+                // The last positional argument takes all remaining parameters as list, without copying them
+                parameters.set_last_positionals( argv + a, argv + argc );
                 break;
             }
 
@@ -183,15 +494,231 @@ bool CmdLineInterface::parse() {
         }
     }
     
-    if ( options_positional != m_cmdline_arguments->options_positional().size() ) {
+    clock.lap( &ParseStats::classify_ns );
+#ifdef CMDLINECPP_PARSE_STATS
+    if ( stats != nullptr ) {
+        stats->options = options_regular;
+    }
+#endif
+    
+    // An option like --files-from can supply the last positional list instead
+    const uint32_t positional_source = arguments.positional_source_id();
+    const bool from_source = positional_source != NameIndex::npos
+                          && options_positional + 1 == positionals.size()
+                          && parameters.value( positional_source ).is_set;
+    
+    if ( options_positional != positionals.size() && !from_source ) {
         throw std::out_of_range("Not all positional arguments are specified.");
     }
+    clock.lap( &ParseStats::validate_ns );
+}
+
 
+void Parser::parse_environment( const CmdLineArguments& arguments
+                              , char* const* environment
+                              , CmdLineParameters& parameters
+) {
+    if ( environment == nullptr ) {
+        return;
+    }
+    
+    const std::string& prefix = arguments.environment_prefix();
+    for ( char* const* entry = environment; *entry != nullptr; entry++ ) {
+        const char* variable = *entry;
+        if ( std::strncmp( variable, prefix.data(), prefix.length() ) != 0 ) {
+            continue;
+        }
+        
+        const char* equals = std::strchr( variable + prefix.length(), '=' );
+        if ( equals == nullptr ) {
+            continue;
+        }
+        
+        const uint32_t option_id = arguments.option_id_of_environment( StringView( variable, equals - variable ) );
+        if ( option_id == NameIndex::npos || parameters.value( option_id ).is_set ) {
+            // Unknown or given on the command line, which always wins
+            continue;
+        }
+        
+        const StringView text( equals + 1 );
+        if ( arguments.option_by_id( option_id ).dataType() == Data::Type::Bool ) {
+            if ( !text.empty() && text != "0" && text != "false" && text != FALSE ) {
+                parameters.set( option_id, TRUE );
+            }
+        } else {
+            parameters.set( option_id, text );
+        }
+    }
+}
+
+
+void Parser::parse_config( const CmdLineArguments& arguments
+                         , const char* data
+                         , size_t size
+                         , CmdLineParameters& parameters
+) {
+    const uint32_t regular_count = static_cast< uint32_t >( arguments.options_regular().size() );
+    
+    // The values of all layers are sorted in by one finish at the end, so remember what was given before
+    std::vector< bool > given( regular_count );
+    for ( uint32_t id = 0; id < regular_count; id++ ) {
+        given[id] = parameters.value( id ).is_set;
+    }
+    
+    ConfigFileReader reader( data, size );
+    std::string section_key;
+    StringView key;
+    StringView text;
+    while ( reader.next( key, text ) ) {
+        StringView name = key;
+        if ( !reader.section().empty() ) {
+            section_key.assign( reader.section().data(), reader.section().length() );
+            section_key += '.';
+            section_key.append( key.data(), key.length() );
+            name = section_key;
+        }
+        
+        const uint32_t option_id = arguments.option_id( name );
+        if ( option_id == NameIndex::npos || option_id >= regular_count ) {
+            continue;
+        }
+        // Only values of earlier layers count, so a key given twice in the file is still added twice
+        if ( given[option_id] ) {
+            continue;
+        }
+        
+        if ( arguments.option_by_id( option_id ).dataType() == Data::Type::Bool ) {
+            if ( text == "true" || text == TRUE || text == "1" ) {
+                parameters.set( option_id, TRUE );
+            } else if ( text != "false" && text != FALSE && text != "0" ) {
+                throw exceptions::ConfigFileError("Expected true or false for '" + name.str() + "' in line " + std::to_string( reader.line() ) + " of the config file.");
+            }
+        } else {
+            parameters.set( option_id, text );
+        }
+    }
+}
+
+
+void Parser::save_schema_cache( const std::string& path, const std::string& stamp ) {
+    m_cmdline_arguments->freeze();
+    
+    std::vector< char > blob;
+    SchemaCache::write( *m_cmdline_arguments, stamp, blob );
+    
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file( temporary.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+        if ( !file || !file.write( blob.data(), blob.size() ) ) {
+            throw std::runtime_error("Could not write the schema cache '" + path + "'.");
+        }
+    }
+    if ( std::rename( temporary.c_str(), path.c_str() ) != 0 ) {
+        std::remove( temporary.c_str() );
+        throw std::runtime_error("Could not write the schema cache '" + path + "'.");
+    }
+}
+
+
+bool Parser::load_schema_cache( const std::string& path, const std::string& stamp ) {
+    MappedFile file;
+    try {
+        if ( !file.open( path ) ) {
+            return false;
+        }
+    } catch ( exceptions::ResponseFileError& ) {
+        return false;
+    }
+    
+    std::unique_ptr< CmdLineArguments > arguments( new CmdLineArguments() );
+    if ( !SchemaCache::read( file.data(), file.size(), stamp, *arguments ) ) {
+        return false;
+    }
+    
+    // The parameters refer to the old definitions
+    this->destroy_parameters();
+    m_cmdline_arguments = std::move( arguments );
+    m_help.clear();
+    this->reset();
+    
     return true;
 }
 
 
-bool CmdLineInterface::parse( int argc, char** argv ) {
+void Parser::save_snapshot( const std::string& path ) const {
+    std::vector< char > blob;
+    Snapshot::write( *m_cmdline_arguments, *m_cmdline_parameters, blob );
+    
+    std::ofstream file( path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !file || !file.write( blob.data(), blob.size() ) ) {
+        throw exceptions::SnapshotError("Could not write the snapshot '" + path + "'.");
+    }
+}
+
+
+void Parser::load_snapshot( const std::string& path ) {
+    std::unique_ptr< MappedFile > snapshot_file( new MappedFile() );
+    try {
+        if ( !snapshot_file->open( path ) ) {
+            throw exceptions::SnapshotError("Could not open the snapshot '" + path + "'.");
+        }
+    } catch ( exceptions::ResponseFileError& error ) {
+        throw exceptions::SnapshotError( error.what() );
+    }
+    
+    this->read_snapshot( std::move( snapshot_file ) );
+}
+
+
+#ifdef __unix__
+
+void Parser::save_snapshot( int fd ) const {
+    std::vector< char > blob;
+    Snapshot::write( *m_cmdline_arguments, *m_cmdline_parameters, blob );
+    
+    size_t written = 0;
+    while ( written < blob.size() ) {
+        const ssize_t bytes = write( fd, blob.data() + written, blob.size() - written );
+        if ( bytes < 0 && errno == EINTR ) {
+            continue;
+        }
+        if ( bytes <= 0 ) {
+            throw exceptions::SnapshotError(std::string("Could not write the snapshot: ") + std::strerror( errno ));
+        }
+        written += static_cast< size_t >( bytes );
+    }
+}
+
+
+void Parser::load_snapshot( int fd ) {
+    std::unique_ptr< MappedFile > snapshot_file( new MappedFile() );
+    try {
+        snapshot_file->open( fd, "snapshot" );
+    } catch ( exceptions::ResponseFileError& error ) {
+        throw exceptions::SnapshotError( error.what() );
+    }
+    
+    this->read_snapshot( std::move( snapshot_file ) );
+}
+
+#endif
+
+
+void Parser::read_snapshot( std::unique_ptr< MappedFile > snapshot_file ) {
+    m_cmdline_arguments->freeze();
+    
+    this->destroy_parameters();
+    m_arena->release();
+    m_response_files.clear();
+    m_config_file.reset();
+    m_snapshot_file = std::move( snapshot_file );
+    this->create_parameters( m_cmdline_arguments.get() );
+    
+    Snapshot::read( *m_cmdline_arguments, m_snapshot_file->data(), m_snapshot_file->size(), *m_cmdline_parameters );
+}
+
+
+bool Parser::parse( int argc, char** argv ) {
     m_argc = argc;
     *this << argv;
     
@@ -199,28 +726,45 @@ bool CmdLineInterface::parse( int argc, char** argv ) {
 }
 
 
-const std::string CmdLineInterface::operator[]( const std::string key ) const {
+const CmdLineArguments& Parser::arguments() {
+    m_cmdline_arguments->freeze();
+    
+    return *m_cmdline_arguments;
+}
+
+
+const std::string Parser::operator[]( const std::string key ) const {
     return m_cmdline_parameters->get( key );
 }
 
 
-bool CmdLineInterface::is_specified( const std::string key ) const {
-    if ( m_cmdline_parameters->is_specified( key ) ) {
-        Option option = m_cmdline_arguments->lookup_option( key );
-        if ( m_cmdline_parameters->get( key ).length() ==  0 && option.dataType() != Data::Type::Bool ) {
-            return false;
-        } else if ( m_cmdline_parameters->get( key ).length() == 0 && option.dataType() == Data::Type::Bool ) {
-            return true;
-        } else {
-            return true;
-        }
+StringView Parser::view( const std::string& key ) const {
+    return m_cmdline_parameters->view( key );
+}
+
+
+bool Parser::is_specified( const StringView& key ) const {
+    const uint32_t id = m_cmdline_arguments->option_id( key );
+    if ( id == NameIndex::npos || id >= m_cmdline_parameters->size() ) {
+        return false;
     }
     
-    return false;
+    const Value& value = m_cmdline_parameters->value( id );
+    return value.type == Data::Type::Bool || value.is_set;
+}
+
+
+uint32_t Parser::option_id( const StringView& key ) const {
+    return m_cmdline_arguments->option_id( key );
+}
+
+
+const Value& Parser::value( uint32_t id ) const {
+    return m_cmdline_parameters->value( id );
 }
 
 
-bool CmdLineInterface::actions_enabled() const {
+bool Parser::actions_enabled() const {
     if ( m_cmdline_arguments->actions().size() > 0 ) {
         return true;
     }
@@ -228,195 +772,218 @@ bool CmdLineInterface::actions_enabled() const {
 }
 
 
-std::vector< std::string > CmdLineInterface::get_last_positionals_as_list() const {
+std::vector< std::string > Parser::get_last_positionals_as_list() const {
     return m_cmdline_parameters->get_last_positionals();
 }
 
 
-const Data::Type CmdLineInterface::dataTypeOfOption( const std::string key ) const {
-    try {
-        Option option = m_cmdline_arguments->lookup_option( key );
-        return option.dataType();
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( key );
-            return option.dataType();
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            return Data::Type::Void;
-        }
+const ArgvSlice& Parser::last_positionals() const {
+    return m_cmdline_parameters->last_positionals();
+}
+
+
+void Parser::define_positional_source( Option option ) {
+    *this << option;
+    m_cmdline_arguments->set_positional_source( option.option() );
+}
+
+
+PositionalStream Parser::positional_stream( PositionalStream::Separator separator ) const {
+    const std::vector< Option >& positionals = m_cmdline_arguments->options_positional();
+    const Data::Type data_type = positionals.empty() ? Data::Type::String : positionals.back().dataType();
+    
+    const uint32_t source = m_cmdline_arguments->positional_source_id();
+    if ( source != NameIndex::npos && m_cmdline_parameters->value( source ).is_set ) {
+        PositionalStream stream( data_type );
+        stream.open( m_cmdline_parameters->value( source ).text.str(), separator );
+        return stream;
     }
     
-    return Data::Type::Void;
+    const ArgvSlice& slice = m_cmdline_parameters->last_positionals();
+    if ( slice.size() == 1 && slice[0] == "-" ) {
+        PositionalStream stream( data_type );
+        stream.open( "-", separator );
+        return stream;
+    }
+    
+    return PositionalStream( slice, data_type );
 }
 
 
-void CmdLineInterface::set_program_name( const std::string program_name ) {
+const Data::Type Parser::dataTypeOfOption( const std::string key ) const {
+    const uint32_t id = m_cmdline_arguments->option_id( key );
+    if ( id == NameIndex::npos ) {
+        return Data::Type::Void;
+    }
+    
+    return m_cmdline_arguments->option_by_id( id ).dataType();
+}
+
+
+void Parser::set_program_name( const std::string program_name ) {
     m_program_name = program_name;
+    m_help.clear();
 }
 
 
-void CmdLineInterface::set_program_description( const std::string program_description ) {
+void Parser::set_program_description( const std::string program_description ) {
     m_program_description = program_description;
+    m_help.clear();
 }
 
 
-void CmdLineInterface::set_program_version( const std::string program_version ) {
+void Parser::set_program_version( const std::string program_version ) {
     m_program_version = program_version;
+    m_help.clear();
 }
 
 
-void CmdLineInterface::define_program( const std::string program_name, const std::string program_description, const std::string program_version ) {
+void Parser::define_program( const std::string program_name, const std::string program_description, const std::string program_version ) {
     this->set_program_name( program_name );
     this->set_program_description( program_description );
     this->set_program_version( program_version );
 }
 
 
-void CmdLineInterface::add_usage_example( const std::string usage_example ) {
+void Parser::add_usage_example( const std::string usage_example ) {
     m_usage_examples.push_back( usage_example );
+    m_help.clear();
 }
 
 
-bool CmdLineInterface::help_requested() const {
-    if ( m_cmdline_parameters->get("help").compare(TRUE) == 0 ) {
+bool Parser::help_requested() const {
+    if ( m_cmdline_parameters->view("help") == TRUE ) {
         return true;
     }
     return false;
 }
 
 
-void CmdLineInterface::print_help() const {
-    std::cout << m_program_name << " v" << m_program_version << std::endl;
-    std::cout << m_program_description << std::endl;
-    std::cout << std::endl;
-    std::cout << m_program_name << " [--help,-h]";
-    if ( this->actions_enabled() ) {
-        std::cout << " <ACTION>";
+const std::string& Parser::help() const {
+    return this->help( HelpLayout::terminal_width() );
+}
+
+
+const std::string& Parser::help( size_t width ) const {
+    for ( size_t h = 0; h < m_help.size(); h++ ) {
+        if ( m_help[h].first == width ) {
+            return m_help[h].second;
+        }
     }
-    std::cout << " [OPTIONS...]";
     
-    for ( unsigned int o = 0
-        ; o < m_cmdline_arguments->options_positional().size()
-        ; o++
-    ) {
-        Option option = m_cmdline_arguments->options_positional().at( o );
-        
-        std::cout << " <" << option.option() << ">";
+    const std::vector< Option >& positionals = m_cmdline_arguments->options_positional();
+    const std::vector< Option >& options = m_cmdline_arguments->options_regular();
+    const std::vector< Action >& actions = m_cmdline_arguments->actions();
+    
+    // One column for the help texts of all sections
+    size_t longest_name = 0;
+    for ( unsigned int a = 0; a < actions.size(); a++ ) {
+        longest_name = std::max( longest_name, HelpLayout::display_width( actions[a].name() ) );
     }
+    for ( unsigned int o = 0; o < options.size(); o++ ) {
+        const size_t name = HelpLayout::display_width( options[o].option_short() ) + HelpLayout::display_width( options[o].option() ) + 5;
+        longest_name = std::max( longest_name, name );
+    }
+    for ( unsigned int o = 0; o < positionals.size(); o++ ) {
+        longest_name = std::max( longest_name, HelpLayout::display_width( positionals[o].option() ) );
+    }
+    const HelpLayout layout( width, longest_name );
+    
+    m_help.push_back( std::make_pair( width, std::string() ) );
+    std::string& help = m_help.back().second;
+    help.reserve( 256 + 128 * ( positionals.size() + options.size() + actions.size() ) );
+    
+    help += m_program_name + " v" + m_program_version + "\n";
+    if ( !m_program_description.empty() ) {
+        layout.append_wrapped( help, m_program_description, 0, 0 );
+        help += "\n";
+    }
+    help += "\n";
+    
+    std::string synopsis = m_program_name + " [--help,-h]";
+    if ( this->actions_enabled() ) {
+        synopsis += " <ACTION>";
+    }
+    synopsis += " [OPTIONS...]";
+    for ( unsigned int o = 0; o < positionals.size(); o++ ) {
+        synopsis += " <" + positionals[o].option() + ">";
+    }
+    layout.append_wrapped( help, synopsis, 0, HelpLayout::indent );
+    help += "\n";
     
     if ( m_usage_examples.size() > 0 ) {
-        std::cout << std::endl;
-        std::cout << std::endl;
-        std::cout << "Usage:" << std::endl;
-        
+        help += "\nUsage:\n";
         for ( unsigned int u = 0; u < m_usage_examples.size(); u++ ) {
-            std::cout << m_usage_examples.at( u ) << std::endl;
+            help.append( HelpLayout::indent, ' ' );
+            layout.append_wrapped( help, m_usage_examples[u], HelpLayout::indent, HelpLayout::indent * 2 );
+            help += "\n";
         }
     }
     
     if ( this->actions_enabled() ) {
-        std::cout << std::endl;
-        std::cout << std::endl;
-        std::cout << "ACTIONS:" << std::endl;
-        
-        for ( unsigned int a = 0
-            ; a < m_cmdline_arguments->actions().size()
-            ; a++
-        ) {
-            Action action = m_cmdline_arguments->actions().at( a );
-            
-            std::cout << "\t" << action.name();
-            std::cout << "\t\t";
-            
-            const std::string help_text = action.help_text();
-            for ( unsigned int pos = 0; pos < help_text.length()+59; pos += 60 ) {
-                if ( pos > 0 ) {
-                    std::cout << "\t\t\t\t";
-                }
-                if ( pos + 60 > help_text.length() ) {
-                    std::cout << help_text.substr( pos );
-                    break;
-                } else {
-                    std::cout << help_text.substr( pos, pos+60 ) << std::endl;
-                }
-            }
-            
-            std::cout << std::endl;
+        help += "\nACTIONS:\n";
+        for ( unsigned int a = 0; a < actions.size(); a++ ) {
+            layout.append_entry( help, actions[a].name(), actions[a].help_text() );
         }
     }
     
-    if ( m_cmdline_arguments->options_regular().size() > 0 ) {
-        std::cout << std::endl;
-        std::cout << std::endl;
-        std::cout << "OPTIONS:" << std::endl;
-        
-        for ( unsigned int o = 0
-            ; o < m_cmdline_arguments->options_regular().size()
-            ; o++
-        ) {
-            Option option = m_cmdline_arguments->options_regular().at( o );
-            
-            std::cout << "\t-" << option.option_short() << ", --" << option.option();
-            if ( option.option().length() < 5 ) {
-                std::cout << "\t\t\t";
-            } else {
-                std::cout << "\t\t";
-            }
-            
-            const std::string help_text = option.help_text();
-            for ( unsigned int pos = 0; pos < help_text.length()+59; pos += 60 ) {
-                if ( pos > 0 ) {
-                    std::cout << "\t\t\t\t";
-                }
-                if ( pos + 60 > help_text.length() ) {
-                    std::cout << help_text.substr( pos );
-                    break;
-                } else {
-                    std::cout << help_text.substr( pos, pos+60 ) << std::endl;
-                }
-            }
-            
-            std::cout << std::endl;
+    if ( options.size() > 0 ) {
+        help += "\nOPTIONS:\n";
+        std::string name;
+        for ( unsigned int o = 0; o < options.size(); o++ ) {
+            name = "-" + options[o].option_short() + ", --" + options[o].option();
+            layout.append_entry( help, name, options[o].help_text() );
         }
     }
     
-    if ( m_cmdline_arguments->options_positional().size() > 0 ) {
-        std::cout << std::endl;
-        std::cout << std::endl;
-        std::cout << "POSITIONAL ARGUMENTS:" << std::endl;
-        for ( unsigned int o = 0
-            ; o < m_cmdline_arguments->options_positional().size()
-            ; o++
-        ) {
-            Option option = m_cmdline_arguments->options_positional().at( o );
-            
-            std::cout << "\t" << option.option();
-            if ( option.option().length() < 5 ) {
-                std::cout << "\t\t";
-            } else {
-                std::cout << "\t";
-            }
-            
-            const std::string help_text = option.help_text();
-            for ( unsigned int pos = 0; pos < help_text.length()+59; pos += 60 ) {
-                if ( pos > 0 ) {
-                    std::cout << "\t\t\t\t";
-                }
-                if ( pos + 60 > help_text.length() ) {
-                    std::cout << help_text.substr( pos );
-                    break;
-                } else {
-                    std::cout << help_text.substr( pos, pos+60 ) << std::endl;
-                }
-            }
-            
-            std::cout << std::endl;
+    if ( positionals.size() > 0 ) {
+        help += "\nPOSITIONAL ARGUMENTS:\n";
+        for ( unsigned int o = 0; o < positionals.size(); o++ ) {
+            layout.append_entry( help, positionals[o].option(), positionals[o].help_text() );
         }
     }
+    
+    return help;
+}
+
+
+void Parser::print_help() const {
+    write_stdout( this->help() );
+}
+
+
+void Parser::answer_completion_request() const {
+    // The shell passes the index of the word to complete and the words of the command line
+    size_t current = 0;
+    try {
+        current = convert::to_unsigned_long( m_argv[2] );
+    } catch ( exceptions::TypeError& ) {
+        return;
+    }
+    
+    std::string completions;
+    Completion::complete( *m_cmdline_arguments, m_argv.data() + 3, m_argv.size() - 3, current, completions );
+    write_stdout( completions );
+}
+
+
+std::string Parser::completion_script( Completion::Shell shell ) const {
+    m_cmdline_arguments->freeze();
+    return Completion::script( *m_cmdline_arguments, m_program_name, shell, m_completion_requests_enabled );
+}
+
+
+void Parser::set_parse_stats_enabled( bool enabled ) {
+    m_parse_stats_enabled = enabled;
 }
 
 
-void CmdLineInterface::print_help_if_requested() const {
+const ParseStats& Parser::parse_stats() const {
+    return m_parse_stats;
+}
+
+
+void Parser::print_help_if_requested() const {
     if ( this->help_requested() ) {
         this->print_help();
         std::exit( 0 );
@@ -424,7 +991,7 @@ void CmdLineInterface::print_help_if_requested() const {
 }
 
 
-const std::string CmdLineInterface::get_selected_action() const {
+const std::string Parser::get_selected_action() const {
     if ( !this->actions_enabled() ) {
         throw std::out_of_range("Actions are not enabled.");
     }
@@ -433,365 +1000,162 @@ const std::string CmdLineInterface::get_selected_action() const {
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, bool& value ) {
-    m_current_option_requested = Data( key );
+const Value& Parser::requested_value( Data::Type data_type, const char* type_name ) const {
     if ( !m_current_option_requested.is_valid() ) {
         throw std::out_of_range("Requested option not set with a Data object.");
     }
     
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::Double ) {
-            throw exceptions::TypeError("Expected double as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::Double ) {
-                throw exceptions::TypeError("Expected double as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::string bool_value = m_cmdline_parameters->get( key );
-    
-    if ( bool_value == TRUE ) {
-        value = true;
-    } else {
-        value = false;
-    }
+    return this->value_of( m_current_option_requested.key(), m_current_option_requested.appearence(), data_type, type_name );
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, double& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
+const Value& Parser::value_of( const StringView& key, unsigned int appearence, Data::Type data_type, const char* type_name ) const {
+    const uint32_t id = m_cmdline_arguments->option_id( key );
+    if ( id == NameIndex::npos ) {
+        throw CmdLineArguments::NotFound("Did not find '" + key.str() + "' as option." + m_cmdline_arguments->suggest_name( key ));
     }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::Double ) {
-            throw exceptions::TypeError("Expected double as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::Double ) {
-                throw exceptions::TypeError("Expected double as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
+    if ( m_cmdline_arguments->option_by_id( id ).dataType() != data_type ) {
+        throw exceptions::TypeError("Expected " + std::string(type_name) + " as data type.");
     }
     
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+    return m_cmdline_parameters->occurrence( id, appearence );
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, long& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::Long ) {
-            throw exceptions::TypeError("Expected long as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::Long ) {
-                throw exceptions::TypeError("Expected long as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+void Parser::to_variable( const StringView& key, bool& value ) {
+    value = this->value_of( key, 0, Data::Type::Bool, "bool" ).as_bool;
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, int& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::Int ) {
-            throw exceptions::TypeError("Expected int as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::Int ) {
-                throw exceptions::TypeError("Expected int as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+void Parser::to_variable( const StringView& key, double& value ) {
+    value = this->value_of( key, 0, Data::Type::Double, "double" ).as_double;
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, short& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::Short ) {
-            throw exceptions::TypeError("Expected short as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::Short ) {
-                throw exceptions::TypeError("Expected short as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+void Parser::to_variable( const StringView& key, long& value ) {
+    value = this->value_of( key, 0, Data::Type::Long, "long" ).as_long;
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, std::string& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::String ) {
-            throw exceptions::TypeError("Expected std::string as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::String ) {
-                throw exceptions::TypeError("Expected std::string as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+void Parser::to_variable( const StringView& key, int& value ) {
+    value = this->value_of( key, 0, Data::Type::Int, "int" ).as_int;
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, unsigned long& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::UnsignedLong ) {
-            throw exceptions::TypeError("Expected unsigned long as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::UnsignedLong ) {
-                throw exceptions::TypeError("Expected unsigned long as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+void Parser::to_variable( const StringView& key, short& value ) {
+    value = this->value_of( key, 0, Data::Type::Short, "short" ).as_short;
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, unsigned int& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::UnsignedInt ) {
-            throw exceptions::TypeError("Expected unsigned int as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::UnsignedInt ) {
-                throw exceptions::TypeError("Expected unsigned int as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+void Parser::to_variable( const StringView& key, std::string& value ) {
+    value = this->value_of( key, 0, Data::Type::String, "std::string" ).text.str();
 }
 
 
-void CmdLineInterface::to_variable( const std::string key, unsigned short& value ) {
-    m_current_option_requested = Data( key );
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    try {
-        Option option = m_cmdline_arguments->lookup_option( m_current_option_requested.key() );
-        if ( option.dataType() != Data::Type::UnsignedShort ) {
-            throw exceptions::TypeError("Expected unsigned short as data type.");
-        }
-    } catch ( CmdLineArguments::NotFound& clanf ) {
-        try {
-            Option option = m_cmdline_arguments->lookup_positional( m_current_option_requested.key() );
-            if ( option.dataType() != Data::Type::UnsignedShort ) {
-                throw exceptions::TypeError("Expected unsigned short as data type.");
-            }
-        } catch ( CmdLineArguments::NotFound& clanf ) {
-            throw CmdLineArguments::NotFound("Did not find '" + m_current_option_requested.key() + "' as option.");
-        }
-    }
-    
-    std::istringstream istring( m_cmdline_parameters->get( key ) );
-    
-    istring >> value;
+void Parser::to_variable( const StringView& key, StringView& value ) {
+    value = this->value_of( key, 0, Data::Type::String, "std::string" ).text;
+}
+
+
+void Parser::to_variable( const StringView& key, unsigned long& value ) {
+    value = this->value_of( key, 0, Data::Type::UnsignedLong, "unsigned long" ).as_unsigned_long;
+}
+
+
+void Parser::to_variable( const StringView& key, unsigned int& value ) {
+    value = this->value_of( key, 0, Data::Type::UnsignedInt, "unsigned int" ).as_unsigned_int;
+}
+
+
+void Parser::to_variable( const StringView& key, unsigned short& value ) {
+    value = this->value_of( key, 0, Data::Type::UnsignedShort, "unsigned short" ).as_unsigned_short;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( Data data_requested ) {
+Parser& Parser::operator>>( const Data& data_requested ) {
     m_current_option_requested = data_requested;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( bool& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    this->to_variable( m_current_option_requested.key(), value );
+Parser& Parser::operator>>( bool& value ) {
+    value = this->requested_value( Data::Type::Bool, "bool" ).as_bool;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( double& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    this->to_variable( m_current_option_requested.key(), value );
+Parser& Parser::operator>>( double& value ) {
+    value = this->requested_value( Data::Type::Double, "double" ).as_double;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( long& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    this->to_variable( m_current_option_requested.key(), value );
+Parser& Parser::operator>>( long& value ) {
+    value = this->requested_value( Data::Type::Long, "long" ).as_long;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( int& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    this->to_variable( m_current_option_requested.key(), value );
+Parser& Parser::operator>>( int& value ) {
+    value = this->requested_value( Data::Type::Int, "int" ).as_int;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( short& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    this->to_variable( m_current_option_requested.key(), value );
+Parser& Parser::operator>>( short& value ) {
+    value = this->requested_value( Data::Type::Short, "short" ).as_short;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( std::string& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
-    
-    this->to_variable( m_current_option_requested.key(), value );
+Parser& Parser::operator>>( std::string& value ) {
+    value = this->requested_value( Data::Type::String, "std::string" ).text.str();
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( unsigned long& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
+Parser& Parser::operator>>( StringView& value ) {
+    value = this->requested_value( Data::Type::String, "std::string" ).text;
     
-    this->to_variable( m_current_option_requested.key(), value );
+    return *this;
+}
+
+
+Parser& Parser::operator>>( unsigned long& value ) {
+    value = this->requested_value( Data::Type::UnsignedLong, "unsigned long" ).as_unsigned_long;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( unsigned int& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
-    }
+Parser& Parser::operator>>( unsigned int& value ) {
+    value = this->requested_value( Data::Type::UnsignedInt, "unsigned int" ).as_unsigned_int;
     
-    this->to_variable( m_current_option_requested.key(), value );
+    return *this;
+}
+
+
+Parser& Parser::operator>>( unsigned short& value ) {
+    value = this->requested_value( Data::Type::UnsignedShort, "unsigned short" ).as_unsigned_short;
     
     return *this;
 }
 
 
-CmdLineInterface& CmdLineInterface::operator>>( unsigned short& value ) {
-    if ( !m_current_option_requested.is_valid() ) {
-        throw std::out_of_range("Requested option not set with a Data object.");
+Occurrences Parser::occurrences( const StringView& key ) const {
+    const uint32_t id = m_cmdline_arguments->option_id( key );
+    if ( id == NameIndex::npos ) {
+        throw CmdLineArguments::NotFound("Did not find '" + key.str() + "' as option." + m_cmdline_arguments->suggest_name( key ));
     }
     
-    this->to_variable( m_current_option_requested.key(), value );
-    
-    return *this;
+    return m_cmdline_parameters->occurrences( id );
 }
 
 
@@ -25,44 +25,99 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <memory>
 
 #include "config.hpp"
 
 #include "arguments.hpp"
+#include "completion.hpp"
+#include "configfile.hpp"
+#include "helplayout.hpp"
 #include "parameters.hpp"
+#include "parsestats.hpp"
+#include "positionalstream.hpp"
+#include "responsefile.hpp"
+#include "schemacache.hpp"
+#include "snapshot.hpp"
 
 
 namespace cmdlinecpp {
 
 /**
- * @brief A global singleton that defines the command line arguments and is able to parse the parameters passed to a main function.
+ * @brief A parser that defines the command line arguments and is able to parse the parameters passed to a main function.
+ * @note Every Parser owns its definitions and parse state and there is no state shared between parsers. So different threads can parse with their own Parser without locking.
  */
-class CmdLineInterface
+class Parser
 {
-    Data& m_current_option_requested;
+    Data m_current_option_requested;
 protected:
     /**
      * @brief The definitions of arguments that have to be passed to the program
      * @note see CmdLineArguments for further information
      */
-    CmdLineArguments* m_cmdline_arguments;
+    std::unique_ptr< CmdLineArguments > m_cmdline_arguments;
     
     /**
      * @brief The number of arguments found on command line for this execution of the binary
      */
     int m_argc;
     /**
-     * @brief The parameters, that are passed to the binary, as list of strings
+     * @brief The parameters, that are passed to the binary, as list of views into the argv array
      */
-    std::vector< std::string > m_argv;
+    std::vector< StringView > m_argv;
+    /**
+     * @brief True, if parse answers a COMPLETION_REQUEST instead of parsing
+     */
+    bool m_completion_requests_enabled;
+    /**
+     * @brief True, if the last parse answered a COMPLETION_REQUEST
+     */
+    bool m_completion_requested;
+    /**
+     * @brief True, if parameters like @file are replaced by the parameters in the file
+     */
+    bool m_response_files_enabled;
+    /**
+     * @brief True, if an unknown parameter with a leading '-' is an error even while a positional argument could take it
+     */
+    bool m_unknown_options_rejected;
+    /**
+     * @brief The response files mapped for the last parse
+     */
+    ResponseFiles m_response_files;
+    /**
+     * @brief The parameters with all response files expanded. Only used, if there was a response file.
+     */
+    std::vector< StringView > m_expanded_argv;
+    /**
+     * @brief The path of the config file with defaults or an empty string
+     */
+    std::string m_config_path;
+    /**
+     * @brief The config file mapped for the last parse. The values of the options point into it.
+     */
+    std::unique_ptr< MappedFile > m_config_file;
+    /**
+     * @brief The snapshot mapped by load_snapshot. The values of the options point into it.
+     */
+    std::unique_ptr< MappedFile > m_snapshot_file;
     
+    /**
+     * @brief The arena all parse state is allocated from. It is released in one step before every parse.
+     */
+    std::unique_ptr< MonotonicArena > m_arena;
     /**
      * @brief The parameters passed to the program ordered by its option key
      * @note see CmdLineParameters for further information
+     * @note The object itself lives in m_arena
      */
     CmdLineParameters* m_cmdline_parameters;
+    /**
+     * @brief True, if the parameters were built by parse for the frozen definitions, so the next parse only resets them
+     */
+    bool m_parameters_reusable;
     
     /**
      * @brief The name of the program, e.g. the binary's name
@@ -80,40 +135,102 @@ protected:
      * @brief A list of string that contain usage examples
      */
     std::vector< std::string > m_usage_examples;
+    /**
+     * @brief The help texts rendered so far, one per line width. A deque, so returned texts stay valid when another width is added.
+     */
+    mutable std::deque< std::pair< size_t, std::string > > m_help;
+    /**
+     * @brief True, if ParseStats are collected while parsing
+     */
+    bool m_parse_stats_enabled;
+    /**
+     * @brief The statistics of the last parse
+     */
+    ParseStats m_parse_stats;
+    
+    /**
+     * @brief Get the value requested with the last Data and check, that the option exists and has the expected data type
+     * @param data_type The Data::Type the caller wants to read
+     * @param type_name The name of the C++ type for the error message
+     * @returns The slot of the requested occurrence of the option
+     * @throws CmdLineArguments::NotFound If no option with this name is defined
+     * @throws TypeError If the option has another Data::Type
+     * @throws std::out_of_range If the option was given less often than requested
+     */
+    const Value& requested_value( Data::Type data_type, const char* type_name ) const;
+    /**
+     * @brief Get a value by the name of its option and check, that the option exists and has the expected data type
+     * @param key The name of the option. It is only looked up, so nothing is copied.
+     * @param appearence The occurrence to get, 0 for the last one
+     * @param data_type The Data::Type the caller wants to read
+     * @param type_name The name of the C++ type for the error message
+     * @returns The slot of the requested occurrence of the option
+     * @throws CmdLineArguments::NotFound If no option with this name is defined
+     * @throws TypeError If the option has another Data::Type
+     * @throws std::out_of_range If the option was given less often than requested
+     */
+    const Value& value_of( const StringView& key, unsigned int appearence, Data::Type data_type, const char* type_name ) const;
+    /**
+     * @brief Create the parameters in the arena
+     * @param cl_args The definitions of the options or nullptr for an empty set of parameters
+     */
+    void create_parameters( const CmdLineArguments* cl_args );
+    /**
+     * @brief Destroy the parameters, so the arena can be released
+     */
+    void destroy_parameters();
+    /**
+     * @brief Replace the parameters by the snapshot in a mapped file
+     * @param snapshot_file The mapped file. It is kept as long as the parameters are used.
+     */
+    void read_snapshot( std::unique_ptr< MappedFile > snapshot_file );
+    /**
+     * @brief Print the completions for the command line after COMPLETION_REQUEST
+     * @note Nothing is printed, if the index of the word is no number.
+     */
+    void answer_completion_request() const;
 
 public:
 
-	/**
-	 * @brief Get a reference to the cmdlineparser object
-	 */
-	static CmdLineInterface& get();
+    /**
+     * @brief Constructor. Constructs a parser that knows only the help option.
+     */
+    Parser();
+    /**
+     * @brief Destructor. Gives back all memory of the parse state.
+     */
+    ~Parser();
+    
+    Parser( const Parser& another ) = delete;
+    Parser& operator=( const Parser& another ) = delete;
 
     /**
      * @brief Defines a new possible action to the command line interface
      * @param action The new action
      * @returns A reference to this object
      */
-    CmdLineInterface& operator<<( Action action );
+    Parser& operator<<( Action action );
     /**
      * @brief Defines a new option to the command line interface
      * @param option The new option
      * @returns A reference to this object
      */
-    CmdLineInterface& operator<<( Option option );
+    Parser& operator<<( Option option );
     /**
      * @brief Pass the number of command line arguments from a main function to the command line interface
      * @param argc The parameter argc as it can be received from the main function's parameters'
      * @returns A reference to this object
      * @note You can also pass argc later with the parse function
      */
-    CmdLineInterface& operator<<( int argc );
+    Parser& operator<<( int argc );
     /**
      * @brief Pass the argv array of the command line arguments from a main function to the command line interface
      * @param argv The parameter argv as it can be received from the main function's parameters
      * @returns A reference to this object
      * @note You can also pass argc later with the parse function
+     * @note The arguments are not copied. Values returned by view and as StringView point into argv, so argv has to outlive the parsed values.
      */
-    CmdLineInterface& operator<<( char** argv );
+    Parser& operator<<( char** argv );
     /**
      * @brief Defines a new option to the command line interface without streaming operator
      * @param option The new option
@@ -130,10 +247,14 @@ public:
      * @brief Parse all command line parameters according to the specified options
      * @param argc The parameter argc as it can be received from the main function's parameters
      * @param argv The parameter argv as it can be received from the main function's parameters
-     * @returns False, if there are not parameters to parse as the argv parameter of the main function was not passed to the command line interface yet.
+     * @returns False, if there are not parameters to parse as the argv parameter of the main function was not passed to the command line interface yet,
+     *          or if a completion request was answered. See completion_requested.
      * @throws std::out_of_range If no parameter is specified for an argument or if not all positional arguments of the command line interface are specified
      * @throws CmdLineArguments::NotFound If an option is not found by the command line parameter parser.
+     * @throws TypeError If a parameter can not be converted to the Data::Type of its option, e.g. an int out of range.
+     * @throws ResponseFileError If a response file includes itself or has a quote that is not closed
      * @note After parsing the command line parameters into this command line interface the values can be received with the operator>> and the to_variable functions.
+     * @note A parameter @file of the cmdline singleton is replaced by the parameters in the file, like gcc does. See set_response_files_enabled.
      */
     bool parse();
     /**
@@ -141,9 +262,156 @@ public:
      * @returns False, if there are not parameters to parse as the argv parameter of the main function was not passed to the command line interface yet.
      * @throws std::out_of_range If no parameter is specified for an argument or if not all positional arguments of the command line interface are specified
      * @throws CmdLineArguments::NotFound If an option is not found by the command line parameter parser.
+     * @throws TypeError If a parameter can not be converted to the Data::Type of its option, e.g. an int out of range.
      * @note After parsing the command line parameters into this command line interface the values can be received with the operator>> and the to_variable functions.
      */
     bool parse( int argc, char** argv );
+    /**
+     * @brief Parse command line parameters into an existing set of parameters without touching any Parser
+     * @param arguments The definitions of the options. They should be frozen, so the lookups do not scan the definitions.
+     * @param argv Views on the command line parameters. The first one is the program name and is skipped.
+     * @param argc The number of views in argv
+     * @param parameters The parameters constructed for arguments to write the values to
+     * @param unknown_options_rejected If true, a parameter with a leading '-' that names no option is an error, even if a positional
+     *        argument could take it. See set_unknown_options_rejected.
+     * @throws std::out_of_range If no parameter is specified for an argument or if not all positional arguments are specified
+     * @throws TypeError If a parameter can not be converted to the Data::Type of its option
+     * @param stats If not nullptr, the phases are timed into it. Only used with CMDLINECPP_PARSE_STATS.
+     * @note This only reads arguments, so many threads can parse with the same frozen definitions at once.
+     * @note Call CmdLineParameters::finish, when all sources are read, before the occurrences are used.
+     */
+    static void parse_parameters( const CmdLineArguments& arguments
+                                , const StringView* argv
+                                , size_t argc
+                                , CmdLineParameters& parameters
+                                , bool unknown_options_rejected = false
+                                , ParseStats* stats = nullptr );
+    /**
+     * @brief Fill the regular options, that were not given on the command line, from their environment variables
+     * @param arguments The definitions of the options. They should be frozen, so every variable costs at most one hash probe.
+     * @param environment The environment as list of "NAME=value" strings that ends with nullptr, like environ
+     * @param parameters The parameters that the command line was parsed into
+     * @throws TypeError If a variable can not be converted to the Data::Type of its option
+     * @note The environment is scanned once. Variables without the common prefix of all option variables are skipped with one compare.
+     * @warning The values point into environment, so it must not change while the parameters are used
+     * @note Call CmdLineParameters::finish, when all sources are read, before the occurrences are used.
+     */
+    static void parse_environment( const CmdLineArguments& arguments
+                                 , char* const* environment
+                                 , CmdLineParameters& parameters );
+    /**
+     * @brief Fill the regular options, that were given neither on the command line nor in the environment, from a config file
+     * @param arguments The definitions of the options. They should be frozen, so every key costs one hash probe.
+     * @param data The contents of the config file
+     * @param size The size of the contents
+     * @param parameters The parameters that the command line and the environment were parsed into
+     * @throws ConfigFileError If a line of the file is invalid
+     * @throws TypeError If a value can not be converted to the Data::Type of its option
+     * @note A key is the name of an option. Inside a section it is section.key. Keys of no regular option are skipped without converting their values.
+     * @warning The values point into data, so it has to outlive the parameters
+     * @note Call CmdLineParameters::finish, when all sources are read, before the occurrences are used.
+     */
+    static void parse_config( const CmdLineArguments& arguments
+                            , const char* data
+                            , size_t size
+                            , CmdLineParameters& parameters );
+    /**
+     * @brief Get the definitions of the options, frozen for fast lookups
+     * @returns The definitions of this parser. They stay frozen until an option or action is added.
+     */
+    const CmdLineArguments& arguments();
+    /**
+     * @brief Enable or disable the expansion of response files
+     * @param enabled If true, every parameter @file is replaced by the parameters in the file, if the file exists. This is the default
+     *        for the cmdline singleton only, so a Parser for parameters from elsewhere, e.g. of a server or a batch, does not
+     *        read the local files they name, like @/etc/shadow.
+     */
+    void set_response_files_enabled( bool enabled );
+    /**
+     * @brief Enable or disable the answer to completion requests
+     * @param enabled If true, parse answers "program --cmdlinecpp-complete <index of the word> <words...>" with one completion
+     *        per line on stdout instead of parsing, and returns false. This is the default for the cmdline singleton only,
+     *        so a Parser for parameters from elsewhere is not made to print by them.
+     */
+    void set_completion_requests_enabled( bool enabled );
+    /**
+     * @brief Enable or disable the rejection of unknown options in place of positional arguments
+     * @param rejected If true, a parameter before -- that starts with '-' and names no option is reported as unknown option,
+     *        even if a positional argument could still take it. A lone "-" and negative numbers like -5 stay positional.
+     *        Otherwise such a parameter is a positional argument and reported only, if no positional argument is left.
+     *        This is the default, so a positional argument like -x.txt keeps working.
+     */
+    void set_unknown_options_rejected( bool rejected );
+    /**
+     * @brief Test, if unknown options are rejected in place of positional arguments
+     * @returns True, if set_unknown_options_rejected enabled it
+     */
+    bool unknown_options_rejected() const;
+    /**
+     * @brief Test, if the last parse answered a completion request instead of parsing
+     * @returns True, if the completions were printed. The program should exit then without doing anything else.
+     */
+    bool completion_requested() const;
+    /**
+     * @brief Read defaults for the options from a config file on every parse
+     * @param path The path of the file or an empty string to read no file. A file that does not exist is skipped.
+     * @note The command line overrides the environment variables, which override the config file.
+     */
+    void set_config_file( const std::string& path );
+    /**
+     * @brief Write all definitions, frozen with their lookup indices, into a cache file for later starts of the program
+     * @param path The path of the file. It is replaced in one step, so other processes never see half of it.
+     * @param stamp A text that changes, whenever the definitions in the program change, e.g. the version of the program
+     * @throws std::runtime_error If the file can not be written
+     */
+    void save_schema_cache( const std::string& path, const std::string& stamp );
+    /**
+     * @brief Replace all definitions by the ones in a cache file written by save_schema_cache
+     * @param path The path of the file
+     * @param stamp The stamp the file has to be written with
+     * @returns False, if the file does not exist, is corrupt or stale. Then define the options in code, as without a cache.
+     * @note The parsed parameters are reset.
+     */
+    bool load_schema_cache( const std::string& path, const std::string& stamp );
+    /**
+     * @brief Write the parsed parameters into a file, so another process can load them without parsing
+     * @param path The path of the file
+     * @throws SnapshotError If the file can not be written
+     */
+    void save_snapshot( const std::string& path ) const;
+    /**
+     * @brief Replace the parameters by the ones in a snapshot file written by save_snapshot
+     * @param path The path of the file
+     * @throws SnapshotError If the file can not be read or was written for other options
+     * @note The file is mapped and the values are not converted or checked again.
+     */
+    void load_snapshot( const std::string& path );
+#ifdef __unix__
+    /**
+     * @brief Write the parsed parameters into a file descriptor, e.g. a memfd that a child process inherits
+     * @param fd The file descriptor. It is not closed.
+     * @throws SnapshotError If the descriptor can not be written
+     */
+    void save_snapshot( int fd ) const;
+    /**
+     * @brief Replace the parameters by the snapshot in an open file, e.g. an inherited memfd
+     * @param fd The file descriptor of a regular file or a memfd. It is not closed and the snapshot has to start at offset 0.
+     * @throws SnapshotError If the file can not be mapped or was written for other options
+     * @note The file is mapped and the values are not converted or checked again.
+     */
+    void load_snapshot( int fd );
+#endif
+    /**
+     * @brief Forget the parsed parameters and give back their memory in one step
+     * @note parse does this itself before parsing again, so memory use stays constant over repeated parses
+     */
+    void reset();
+    /**
+     * @brief Allocate the parse state from another memory resource, e.g. a MonotonicArena over a stack buffer
+     * @param upstream The resource the arena of the parse state takes its chunks from. It has to outlive this object.
+     * @note This forgets the parsed parameters like reset
+     */
+    void use_memory_resource( MemoryResource* upstream );
     
     /**
      * @brief Get the value for an argument
@@ -152,13 +420,43 @@ public:
      * @note You should have added options to this command line interface and have parsed the command line parameters first
      */
     const std::string operator[]( const std::string key ) const;
+    /**
+     * @brief Get the value for an argument without copying it
+     * @param key The name of the argument to look up
+     * @returns A view into the argv array on the value found for the argument or an empty view, if no argument for key exists
+     * @note You should have added options to this command line interface and have parsed the command line parameters first
+     */
+    StringView view( const std::string& key ) const;
     /**
      * @brief Test, if an argument specified by key is specified by this command line interface
      * @param key The name of the argument to look for
      * @returns True, if the an option with the name key is found in this command line interface
      * @note You should have added options to this command line interface and have parsed the command line parameters first
      */
-    bool is_specified( const std::string key ) const;
+    bool is_specified( const StringView& key ) const;
+    /**
+     * @brief Get the id of an option to access its value directly with value
+     * @param key The name of the option to look up
+     * @returns The id of the option or NameIndex::npos, if no option with this name is defined
+     * @note Look the id up once and keep it, if the value is read often, e.g. in a loop
+     */
+    uint32_t option_id( const StringView& key ) const;
+    /**
+     * @brief Get the converted value of an option by its id
+     * @param id The id of the option as returned by option_id
+     * @returns The slot holding the value. Read the member matching the option's Data::Type.
+     * @throws std::out_of_range If there is no option with this id
+     * @note You should have parsed the command line parameters first
+     */
+    const Value& value( uint32_t id ) const;
+    /**
+     * @brief Get all values given for an option that may be passed multiple times
+     * @param key The name of the option to look up
+     * @returns A range over the values in the order they were given, e.g. for "--include a --include b" the values a and b
+     * @throws CmdLineArguments::NotFound If no option with this name is defined
+     * @note The range does not copy the values. It stays valid until the next parse.
+     */
+    Occurrences occurrences( const StringView& key ) const;
     /**
      * @brief Test, if actions are enabled
      * @returns True, if at least one action is needed
@@ -166,9 +464,28 @@ public:
     bool actions_enabled() const;
     /**
      * @brief Get the last positional parameters as list
-     * @returns A vector containing the last positional elements
+     * @returns A vector containing the value of the last positional argument and all parameters behind it, also if it is only one
+     * @note This copies every parameter. Use last_positionals for long lists.
      */
     std::vector< std::string > get_last_positionals_as_list() const;
+    /**
+     * @brief Get the last positional parameters without copying them
+     * @returns A slice of the parsed parameters, starting with the value of the last positional argument. It stays valid until the next parse.
+     */
+    const ArgvSlice& last_positionals() const;
+    /**
+     * @brief Defines an option that names a file to read the last positional list from, e.g. --files-from
+     * @param option The new option. Its value is a path or "-" for stdin. If it is given, the last positional argument may be missing on the command line.
+     */
+    void define_positional_source( Option option );
+    /**
+     * @brief Get a stream over the last positional list, that reads large lists while the program consumes them
+     * @param separator How the items are separated, if they are read from a file or stdin
+     * @returns A stream that reads the file of the option defined with define_positional_source, if it is given. Otherwise stdin, if the list is only "-". Otherwise the list from the command line.
+     * @throws std::runtime_error If the file can not be opened
+     * @note The items are converted to the Data::Type of the last positional argument.
+     */
+    PositionalStream positional_stream( PositionalStream::Separator separator = PositionalStream::Separator::Newline ) const;
     
     /**
      * @brief Get the data type used by an option that is specified for this command line interface
@@ -211,8 +528,20 @@ public:
      * @returns True, if either --help or -h were specified
      */
     bool help_requested() const;
+    /**
+     * @brief Get the formatted help for the terminal stdout is connected to
+     * @returns The help text. It is rendered once per width and kept until an option, action or program detail changes.
+     */
+    const std::string& help() const;
+    /**
+     * @brief Get the formatted help for a line width
+     * @param width The width of a line in display cells
+     * @returns The help text. It is rendered once per width and kept until an option, action or program detail changes.
+     */
+    const std::string& help( size_t width ) const;
     /**
      * @brief Print a formatted help
+     * @note The help is written to stdout in one piece, with a single write call on unix.
      */
     void print_help() const;
     /**
@@ -221,6 +550,26 @@ public:
      * @warning Exits the program with status code 0, if help is requested
      */
     void print_help_if_requested() const;
+    /**
+     * @brief Generate a completion script for a shell
+     * @param shell The shell
+     * @returns The script for the program name set with set_program_name
+     * @note If completion requests are enabled, the script runs "program --cmdlinecpp-complete <index of the word> <words...>"
+     *       to complete options and actions. Otherwise it completes from the definitions alone.
+     */
+    std::string completion_script( Completion::Shell shell ) const;
+    
+    /**
+     * @brief Collect statistics while parsing or stop it. It is off by default.
+     * @param enabled If true, every parse fills the statistics returned by parse_stats
+     * @note Without CMDLINECPP_PARSE_STATS in config.hpp the collection is compiled out and this has no effect.
+     */
+    void set_parse_stats_enabled( bool enabled );
+    /**
+     * @brief Get the statistics of the last parse
+     * @returns The statistics. ParseStats::collected is false, if they were not collected.
+     */
+    const ParseStats& parse_stats() const;
     
     /**
      * @brief Get the selected action, if enabled
@@ -231,62 +580,69 @@ public:
     /**
      * @brief Specify the requested data's key and occurence to get as next output of the operator>> functions
      * @param data_requested A Data that specifies at least a key and optionally a appearence number, if the parameter is to be passed multiple times to the program
+     * @note Without an appearence number the last value given for the option is returned.
      */
-    CmdLineInterface& operator>>( Data data_requested );
+    Parser& operator>>( const Data& data_requested );
     /**
      * @brief Get the value of the last requested Data to a bool reference
      * @param value The reference to the bool variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not bool or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( bool& value );
+    Parser& operator>>( bool& value );
     /**
      * @brief Get the value of the last requested Data to a double reference
      * @param value The reference to the double variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not double or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( double& value );
+    Parser& operator>>( double& value );
     /**
      * @brief Get the value of the last requested Data to a long reference
      * @param value The reference to the long variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not long or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( long& value );
+    Parser& operator>>( long& value );
     /**
      * @brief Get the value of the last requested Data to a int reference
      * @param value The reference to the int variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not int or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( int& value );
+    Parser& operator>>( int& value );
     /**
      * @brief Get the value of the last requested Data to a short reference
      * @param value The reference to the short variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not short or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( short& value );
+    Parser& operator>>( short& value );
     /**
      * @brief Get the value of the last requested Data to a std::string reference
      * @param value The reference to the std::string variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not std::string or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( std::string& value );
+    Parser& operator>>( std::string& value );
+    /**
+     * @brief Get a view on the value of the last requested Data without copying it
+     * @param value The reference to the StringView variable to write the value to
+     * @throws TypeError If the Data::Type of the parameter is not std::string or Data was not specified properly for requesting a value
+     */
+    Parser& operator>>( StringView& value );
     /**
      * @brief Get the value of the last requested Data to a unsigned long reference
      * @param value The reference to the unsigned long variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not unsigned long or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( unsigned long& value );
+    Parser& operator>>( unsigned long& value );
     /**
      * @brief Get the value of the last requested Data to a unsigned int reference
      * @param value The reference to the unsigned int variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not unsigned int or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( unsigned int& value );
+    Parser& operator>>( unsigned int& value );
     /**
      * @brief Get the value of the last requested Data to a unsigned short reference
      * @param value The reference to the unsigned short variable to write the value to
      * @throws TypeError If the Data::Type of the parameter is not unsigned short or Data was not specified properly for requesting a value
      */
-    CmdLineInterface& operator>>( unsigned short& value );
+    Parser& operator>>( unsigned short& value );
     
     /**
      * @brief Write the parameter's value to a bool reference
@@ -295,7 +651,7 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not bool
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, bool& value );
+    void to_variable( const StringView& key, bool& value );
     /**
      * @brief Write the parameter's value to a bool reference
      * @param key The name of the option to look up
@@ -303,7 +659,7 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not bool
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, double& value );
+    void to_variable( const StringView& key, double& value );
     /**
      * @brief Write the parameter's value to a long reference
      * @param key The name of the option to look up
@@ -311,7 +667,7 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not long
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, long& value );
+    void to_variable( const StringView& key, long& value );
     /**
      * @brief Write the parameter's value to a int reference
      * @param key The name of the option to look up
@@ -319,7 +675,7 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not int
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, int& value );
+    void to_variable( const StringView& key, int& value );
     /**
      * @brief Write the parameter's value to a short reference
      * @param key The name of the option to look up
@@ -327,7 +683,7 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not short
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, short& value );
+    void to_variable( const StringView& key, short& value );
     /**
      * @brief Write the parameter's value to a std::string reference
      * @param key The name of the option to look up
@@ -335,7 +691,15 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not std::string
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, std::string& value );
+    void to_variable( const StringView& key, std::string& value );
+    /**
+     * @brief Write a view on the parameter's value to a StringView reference
+     * @param key The name of the option to look up
+     * @param value The reference to the StringView variable to write the value to
+     * @throws TypeError If the Data::Type of the parameter is not std::string
+     * @note Use this as alternative to the default streaming API's operator>>
+     */
+    void to_variable( const StringView& key, StringView& value );
     /**
      * @brief Write the parameter's value to a unsigned long reference
      * @param key The name of the option to look up
@@ -343,7 +707,7 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not unsigned long
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, unsigned long& value );
+    void to_variable( const StringView& key, unsigned long& value );
     /**
      * @brief Write the parameter's value to a unsigned int reference
      * @param key The name of the option to look up
@@ -351,7 +715,7 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not unsigned int
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, unsigned int& value );
+    void to_variable( const StringView& key, unsigned int& value );
     /**
      * @brief Write the parameter's value to a unsigned short reference
      * @param key The name of the option to look up
@@ -359,15 +723,27 @@ public:
      * @throws TypeError If the Data::Type of the parameter is not unsigned short
      * @note Use this as alternative to the default streaming API's operator>>
      */
-    void to_variable( const std::string key, unsigned short& value );
-    
-    
-private:
-	static std::unique_ptr< CmdLineInterface > ms_cmdlineparser;
+    void to_variable( const StringView& key, unsigned short& value );
+};
+
+
+/**
+ * @brief The global Parser used by the cmdline macro
+ */
+class CmdLineInterface : public Parser
+{
+public:
 
+	/**
+	 * @brief Get a reference to the cmdlineparser object
+	 * @note The object is created on the first call. This is thread safe.
+	 */
+	static CmdLineInterface& get();
+	
+private:
 	CmdLineInterface();
 	CmdLineInterface( CmdLineInterface const& another) = delete;
-	CmdLineInterface& operator=( CmdLineInterface const& another );
+	CmdLineInterface& operator=( CmdLineInterface const& another ) = delete;
 };
 
 } // namespace cmdlinecpp
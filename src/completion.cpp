@@ -0,0 +1,387 @@
+/**
+ * @file completion.cpp
+ * @brief A file that defines the shell completion for the defined options
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include "completion.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief Make a shell function name out of the program name
+ */
+std::string identifier( const std::string& program ) {
+    std::string result = program;
+    for ( size_t c = 0; c < result.length(); c++ ) {
+        const char ch = result[c];
+        if ( !( ( ch >= 'a' && ch <= 'z' ) || ( ch >= 'A' && ch <= 'Z' ) || ( ch >= '0' && ch <= '9' ) ) ) {
+            result[c] = '_';
+        }
+    }
+    return result;
+}
+
+
+/**
+ * @brief Quote a text for a shell in single quotes
+ * @param text The text
+ * @param escape The escape for a single quote inside the quotes
+ */
+std::string quote( const std::string& text, const char* escape ) {
+    std::string result = "'";
+    for ( size_t c = 0; c < text.length(); c++ ) {
+        if ( text[c] == '\'' ) {
+            result += escape;
+        } else if ( text[c] == '\n' ) {
+            result += ' ';
+        } else {
+            result += text[c];
+        }
+    }
+    return result + "'";
+}
+
+
+/**
+ * @brief Escape a text for the description or message of a zsh _arguments spec
+ */
+std::string zsh_escape( const std::string& text ) {
+    std::string result;
+    for ( size_t c = 0; c < text.length(); c++ ) {
+        const char ch = text[c];
+        if ( ch == '[' || ch == ']' || ch == ':' || ch == '\\' ) {
+            result += '\\';
+        }
+        result += ch;
+    }
+    return result;
+}
+
+
+/**
+ * @brief Escape a text for a single quoted string of fish
+ */
+std::string fish_escape( const std::string& text ) {
+    std::string result;
+    for ( size_t c = 0; c < text.length(); c++ ) {
+        if ( text[c] == '\\' || text[c] == '\'' ) {
+            result += '\\';
+        }
+        result += text[c] == '\n' ? ' ' : text[c];
+    }
+    return result;
+}
+
+
+std::string bash_script( const CmdLineArguments& arguments, const std::string& program, bool ask_program ) {
+    const std::vector< Option >& options = arguments.options_regular();
+    const std::vector< Action >& actions = arguments.actions();
+    const std::string function = "_" + identifier( program ) + "_complete";
+
+    std::string file_values;
+    std::string other_values;
+    std::string words;
+    for ( size_t o = 0; o < options.size(); o++ ) {
+        const std::string specifiers = "--" + options[o].option() + "|-" + options[o].option_short();
+        if ( options[o].dataType() == Data::Type::String ) {
+            file_values += ( file_values.empty() ? "" : "|" ) + specifiers;
+        } else if ( options[o].dataType() != Data::Type::Bool ) {
+            other_values += ( other_values.empty() ? "" : "|" ) + specifiers;
+        }
+        words += ( words.empty() ? "--" : " --" ) + options[o].option() + " -" + options[o].option_short();
+    }
+
+    std::string script = "# bash completion for " + program + ", generated by LibCmdLineC++\n";
+    script += function + "() {\n";
+    script += "    local cur=\"${COMP_WORDS[COMP_CWORD]}\"\n";
+    script += "    local prev=\"${COMP_WORDS[COMP_CWORD-1]}\"\n";
+    script += "    COMPREPLY=()\n";
+    if ( !file_values.empty() || !other_values.empty() ) {
+        script += "    case \"$prev\" in\n";
+        if ( !file_values.empty() ) {
+            script += "        " + file_values + ")\n";
+            script += "            COMPREPLY=( $(compgen -f -- \"$cur\") )\n";
+            script += "            return 0\n";
+            script += "            ;;\n";
+        }
+        if ( !other_values.empty() ) {
+            script += "        " + other_values + ")\n";
+            script += "            return 0\n";
+            script += "            ;;\n";
+        }
+        script += "    esac\n";
+    }
+    if ( ask_program ) {
+        // The program answers with the options and actions that start with the current word
+        script += "    local IFS=$'\\n'\n";
+        script += "    COMPREPLY=( $(\"${COMP_WORDS[0]}\" " COMPLETION_REQUEST " \"$COMP_CWORD\" \"${COMP_WORDS[@]}\" 2>/dev/null) )\n";
+    } else {
+        script += "    if [[ \"$cur\" == -* ]]; then\n";
+        script += "        COMPREPLY=( $(compgen -W " + quote( words, "'\\''" ) + " -- \"$cur\") )\n";
+        script += "        return 0\n";
+        script += "    fi\n";
+    }
+    if ( !ask_program && !actions.empty() ) {
+        std::string names;
+        for ( size_t a = 0; a < actions.size(); a++ ) {
+            names += ( a > 0 ? " " : "" ) + actions[a].name();
+        }
+        script += "    COMPREPLY=( $(compgen -W " + quote( names, "'\\''" ) + " -- \"$cur\") )\n";
+    }
+    script += "    if [ ${#COMPREPLY[@]} -eq 0 ]; then\n";
+    script += "        COMPREPLY=( $(compgen -f -- \"$cur\") )\n";
+    script += "    fi\n";
+    script += "}\n";
+    script += "complete -F " + function + " " + program + "\n";
+    return script;
+}
+
+
+std::string zsh_request_script( const CmdLineArguments& arguments, const std::string& program ) {
+    const std::vector< Option >& options = arguments.options_regular();
+    const std::string function = "_" + identifier( program ) + "_complete";
+
+    std::string file_values;
+    std::string other_values;
+    for ( size_t o = 0; o < options.size(); o++ ) {
+        const std::string specifiers = "--" + options[o].option() + "|-" + options[o].option_short();
+        if ( options[o].dataType() == Data::Type::String ) {
+            file_values += ( file_values.empty() ? "" : "|" ) + specifiers;
+        } else if ( options[o].dataType() != Data::Type::Bool ) {
+            other_values += ( other_values.empty() ? "" : "|" ) + specifiers;
+        }
+    }
+
+    std::string script = "#compdef " + program + "\n";
+    script += "# zsh completion for " + program + ", generated by LibCmdLineC++\n";
+    script += function + "() {\n";
+    if ( !file_values.empty() || !other_values.empty() ) {
+        script += "    case \"${words[CURRENT-1]}\" in\n";
+        if ( !file_values.empty() ) {
+            script += "        " + file_values + ")\n";
+            script += "            _files\n";
+            script += "            return\n";
+            script += "            ;;\n";
+        }
+        if ( !other_values.empty() ) {
+            script += "        " + other_values + ")\n";
+            script += "            return 1\n";
+            script += "            ;;\n";
+        }
+        script += "    esac\n";
+    }
+    // The program answers with the options and actions that start with the current word
+    script += "    local -a completions\n";
+    script += "    completions=( ${(f)\"$(\"${words[1]}\" " COMPLETION_REQUEST " $(( CURRENT - 1 )) \"${words[@]}\" 2>/dev/null)\"} )\n";
+    script += "    if (( ${#completions} )); then\n";
+    script += "        compadd -a completions\n";
+    script += "    else\n";
+    script += "        _files\n";
+    script += "    fi\n";
+    script += "}\n";
+    script += function + " \"$@\"\n";
+    return script;
+}
+
+
+std::string zsh_script( const CmdLineArguments& arguments, const std::string& program, bool ask_program ) {
+    const std::vector< Option >& options = arguments.options_regular();
+    const std::vector< Option >& positionals = arguments.options_positional();
+    const std::vector< Action >& actions = arguments.actions();
+
+    if ( ask_program ) {
+        return zsh_request_script( arguments, program );
+    }
+
+    std::string script = "#compdef " + program + "\n";
+    script += "# zsh completion for " + program + ", generated by LibCmdLineC++\n";
+    script += "_arguments";
+    for ( size_t o = 0; o < options.size(); o++ ) {
+        const Option& option = options[o];
+        // Both names share the description, e.g. '(-o --output)'{-o,--output}'[The output file.]:output:_files'
+        std::string spec = "[" + zsh_escape( option.help_text() ) + "]";
+        if ( option.dataType() == Data::Type::String ) {
+            spec += ":" + zsh_escape( option.option() ) + ":_files";
+        } else if ( option.dataType() != Data::Type::Bool ) {
+            spec += ":" + zsh_escape( option.option() ) + ": ";
+        }
+        script += " \\\n    '(-" + option.option_short() + " --" + option.option() + ")'"
+                + "{-" + option.option_short() + ",--" + option.option() + "}"
+                + quote( spec, "'\\''" );
+    }
+
+    size_t position = 1;
+    if ( !actions.empty() ) {
+        std::string names;
+        for ( size_t a = 0; a < actions.size(); a++ ) {
+            names += ( a > 0 ? " " : "" ) + zsh_escape( actions[a].name() );
+        }
+        script += " \\\n    " + quote( std::to_string( position ) + ":ACTION:(" + names + ")", "'\\''" );
+        ++position;
+    }
+    for ( size_t p = 0; p < positionals.size(); p++ ) {
+        const std::string number = ( p + 1 == positionals.size() ) ? "*" : std::to_string( position + p );
+        const std::string action = positionals[p].dataType() == Data::Type::String ? "_files" : " ";
+        script += " \\\n    " + quote( number + ":" + zsh_escape( positionals[p].option() ) + ":" + action, "'\\''" );
+    }
+    script += "\n";
+    return script;
+}
+
+
+std::string fish_script( const CmdLineArguments& arguments, const std::string& program, bool ask_program ) {
+    const std::vector< Option >& options = arguments.options_regular();
+    const std::vector< Option >& positionals = arguments.options_positional();
+    const std::vector< Action >& actions = arguments.actions();
+
+    std::string script = "# fish completion for " + program + ", generated by LibCmdLineC++\n";
+
+    bool files = false;
+    for ( size_t p = 0; p < positionals.size(); p++ ) {
+        files = files || positionals[p].dataType() == Data::Type::String;
+    }
+    if ( !files ) {
+        script += "complete -c " + program + " -f\n";
+    }
+
+    for ( size_t o = 0; o < options.size(); o++ ) {
+        const Option& option = options[o];
+        script += "complete -c " + program;
+        script += ( option.option_short().length() == 1 ? " -s " : " -o " ) + option.option_short();
+        script += " -l " + option.option();
+        if ( option.dataType() == Data::Type::String ) {
+            script += " -r";
+        } else if ( option.dataType() != Data::Type::Bool ) {
+            script += " -x";
+        }
+        if ( option.has_help_text() ) {
+            script += " -d '" + fish_escape( option.help_text() ) + "'";
+        }
+        script += "\n";
+    }
+
+    if ( ask_program ) {
+        // The options are completed from the lines above, the program answers with the actions
+        const std::string function = "__" + identifier( program ) + "_complete";
+        script += "function " + function + "\n";
+        script += "    set -l token (commandline -ct)\n";
+        script += "    string match -q -- '-*' $token; and return\n";
+        script += "    set -l words (commandline -opc) $token\n";
+        script += "    $words[1] " COMPLETION_REQUEST " (math (count $words) - 1) $words 2>/dev/null\n";
+        script += "end\n";
+        script += "complete -c " + program + " -a '(" + function + ")'\n";
+        return script;
+    }
+
+    for ( size_t a = 0; a < actions.size(); a++ ) {
+        script += "complete -c " + program + " -n __fish_use_subcommand -x -a '" + fish_escape( actions[a].name() ) + "'";
+        if ( !actions[a].help_text().empty() ) {
+            script += " -d '" + fish_escape( actions[a].help_text() ) + "'";
+        }
+        script += "\n";
+    }
+    return script;
+}
+
+} // namespace
+
+
+std::string Completion::script( const CmdLineArguments& arguments
+                              , const std::string& program
+                              , Shell shell
+                              , bool ask_program
+) {
+    switch ( shell ) {
+        case Shell::Zsh:
+            return zsh_script( arguments, program, ask_program );
+        case Shell::Fish:
+            return fish_script( arguments, program, ask_program );
+        default:
+            return bash_script( arguments, program, ask_program );
+    }
+}
+
+
+void Completion::complete( const CmdLineArguments& arguments
+                         , const StringView* words
+                         , size_t count
+                         , size_t current
+                         , std::string& out
+) {
+    const StringView word = current < count ? words[current] : StringView();
+
+    // Walk the words in front of the current one like parse does
+    bool action_given = false;
+    for ( size_t w = 1; w < current && w < count; w++ ) {
+        if ( words[w] == END_OF_OPTIONS ) {
+            // Only positional parameters follow, which are file names or values
+            return;
+        }
+
+        const uint32_t id = arguments.option_id_of_parameter( words[w] );
+        if ( id != NameIndex::npos ) {
+            if ( arguments.option_by_id( id ).dataType() != Data::Type::Bool ) {
+                if ( w + 1 == current ) {
+                    // The current word is the value of this option
+                    return;
+                }
+                ++w;
+            }
+        } else if ( arguments.are_actions_enabled() && arguments.is_action( words[w] ) ) {
+            action_given = true;
+        }
+    }
+
+    // The names are searched by prefix in the frozen definitions, so the options that do not match cost nothing
+    if ( word.starts_with( "-" ) ) {
+        const std::vector< Option >& options = arguments.options_regular();
+        const bool long_only = word.starts_with( "--" );
+        if ( long_only || word.length() == 1 ) {
+            const std::pair< const uint32_t*, const uint32_t* > found = arguments.options_with_prefix( word.substr( 2 ), false );
+            for ( const uint32_t* o = found.first; o != found.second; ++o ) {
+                out += "--" + options[*o].option() + "\n";
+            }
+        }
+        if ( !long_only ) {
+            const std::pair< const uint32_t*, const uint32_t* > found = arguments.options_with_prefix( word.substr( 1 ), true );
+            for ( const uint32_t* o = found.first; o != found.second; ++o ) {
+                out += "-" + options[*o].option_short() + "\n";
+            }
+        }
+    } else if ( arguments.are_actions_enabled() && !action_given ) {
+        const std::vector< Action >& actions = arguments.actions();
+        const std::pair< const uint32_t*, const uint32_t* > found = arguments.actions_with_prefix( word );
+        for ( const uint32_t* a = found.first; a != found.second; ++a ) {
+            out += actions[*a].name() + "\n";
+        }
+    }
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,90 @@
+/**
+ * @file completion.hpp
+ * @brief A file that defines the shell completion for the defined options
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "arguments.hpp"
+#include "stringview.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @def COMPLETION_REQUEST
+ * @brief Macro that represents the parameter, that makes parse answer a completion request instead of parsing
+ */
+#define COMPLETION_REQUEST "--cmdlinecpp-complete"
+
+
+/**
+ * @brief Generates completion scripts for bash, zsh and fish and answers completion requests
+ */
+class Completion {
+public:
+    /**
+     * @brief The shells completion scripts can be generated for
+     */
+    enum class Shell {
+        Bash,
+        Zsh,
+        Fish
+    };
+
+    /**
+     * @brief Generate a completion script
+     * @param arguments The definitions of the options
+     * @param program The name of the program as the user types it
+     * @param shell The shell to generate the script for
+     * @param ask_program True, if the program answers COMPLETION_REQUEST. The script then runs it to complete options and actions.
+     *        Otherwise the script contains all options and actions, so the shell completes without running the program.
+     * @returns The script
+     * @note Values of String options and positional arguments are completed as file names, other values are not completed.
+     */
+    static std::string script( const CmdLineArguments& arguments
+                             , const std::string& program
+                             , Shell shell
+                             , bool ask_program );
+
+    /**
+     * @brief Find the completions of a word on a command line
+     * @param arguments The definitions of the options. They must be frozen, the names are searched by prefix.
+     * @param words The words of the command line. The first one is the program name.
+     * @param count The number of words
+     * @param current The index of the word to complete. It may be count, if a new word is started.
+     * @param out Is appended the completions, one per line. Nothing is appended, if the word is a file name or a value without completions.
+     */
+    static void complete( const CmdLineArguments& arguments
+                        , const StringView* words
+                        , size_t count
+                        , size_t current
+                        , std::string& out );
+};
+
+
+} // namespace cmdlinecpp
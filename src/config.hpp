@@ -61,3 +61,9 @@
 #endif
 
 #endif
+
+
+// Collect ParseStats while parsing, if it is enabled with Parser::set_parse_stats_enabled.
+// Without this macro the collection is compiled out and parse_stats stays empty.
+
+//#define CMDLINECPP_PARSE_STATS
@@ -0,0 +1,141 @@
+/**
+ * @file configfile.cpp
+ * @brief A file that defines the reader of config files with defaults for the options
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <cstring>
+#include <string>
+
+#include "configfile.hpp"
+#include "exceptions.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+bool is_blank( char c ) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+
+/**
+ * @brief Remove blanks at both ends of a range
+ */
+StringView trim( const char* begin, const char* end ) {
+    while ( begin != end && is_blank( *begin ) ) {
+        ++begin;
+    }
+    while ( end != begin && is_blank( end[-1] ) ) {
+        --end;
+    }
+    return StringView( begin, end - begin );
+}
+
+} // namespace
+
+
+ConfigFileReader::ConfigFileReader( const char* data, size_t size )
+    :   m_current( data )
+    ,   m_end( data + size )
+    ,   m_line( 0 )
+    ,   m_section()
+{}
+
+
+bool ConfigFileReader::next( StringView& key, StringView& value ) {
+    while ( m_current != m_end ) {
+        const char* begin = m_current;
+        const char* end = static_cast< const char* >( std::memchr( begin, '\n', m_end - begin ) );
+        if ( end == nullptr ) {
+            end = m_end;
+            m_current = m_end;
+        } else {
+            m_current = end + 1;
+        }
+        ++m_line;
+
+        while ( begin != end && is_blank( *begin ) ) {
+            ++begin;
+        }
+        if ( begin == end || *begin == '#' || *begin == ';' ) {
+            continue;
+        }
+
+        if ( *begin == '[' ) {
+            const char* close = static_cast< const char* >( std::memchr( begin, ']', end - begin ) );
+            if ( close == nullptr ) {
+                throw exceptions::ConfigFileError("Missing ] in line " + std::to_string( m_line ) + " of the config file.");
+            }
+            m_section = trim( begin + 1, close );
+            continue;
+        }
+
+        const char* equals = static_cast< const char* >( std::memchr( begin, '=', end - begin ) );
+        if ( equals == nullptr ) {
+            throw exceptions::ConfigFileError("Missing = in line " + std::to_string( m_line ) + " of the config file.");
+        }
+        key = trim( begin, equals );
+        if ( key.empty() ) {
+            throw exceptions::ConfigFileError("Missing key in line " + std::to_string( m_line ) + " of the config file.");
+        }
+
+        const char* first = equals + 1;
+        while ( first != end && is_blank( *first ) ) {
+            ++first;
+        }
+        if ( first != end && ( *first == '"' || *first == '\'' ) ) {
+            const char* quote = static_cast< const char* >( std::memchr( first + 1, *first, end - first - 1 ) );
+            if ( quote == nullptr ) {
+                throw exceptions::ConfigFileError(std::string("Missing closing ") + *first + " in line " + std::to_string( m_line ) + " of the config file.");
+            }
+            value = StringView( first + 1, quote - first - 1 );
+        } else {
+            // A comment behind the value starts with whitespace and '#' or ';'
+            const char* last = first;
+            while ( last != end && !( ( *last == '#' || *last == ';' ) && last != first && is_blank( last[-1] ) ) ) {
+                ++last;
+            }
+            value = trim( first, last );
+        }
+        return true;
+    }
+
+    return false;
+}
+
+
+const StringView& ConfigFileReader::section() const {
+    return m_section;
+}
+
+
+size_t ConfigFileReader::line() const {
+    return m_line;
+}
+
+
+} // namespace cmdlinecpp
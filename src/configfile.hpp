@@ -0,0 +1,79 @@
+/**
+ * @file configfile.hpp
+ * @brief A file that defines the reader of config files with defaults for the options
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "stringview.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief Splits the contents of an INI or TOML like config file into entries without copying them
+ *
+ * Every line is empty, a comment starting with '#' or ';', a section like [section] or an entry like
+ * key = value. Values can be quoted with '"' or '\'', the quotes are removed, but there are no escapes.
+ * A comment behind an unquoted value has to be separated by whitespace.
+ */
+class ConfigFileReader {
+    const char* m_current;
+    const char* m_end;
+    size_t m_line;
+    StringView m_section;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param data The contents of the config file
+     * @param size The size of the contents
+     */
+    ConfigFileReader( const char* data, size_t size );
+
+    /**
+     * @brief Get the next entry
+     * @param key Is set to a view on the key of the entry
+     * @param value Is set to a view on the value of the entry
+     * @returns False, if there are no more entries
+     * @throws ConfigFileError If a line is neither empty, a comment, a section nor an entry
+     */
+    bool next( StringView& key, StringView& value );
+
+    /**
+     * @brief Get the section of the entry returned last
+     * @returns The name of the section or an empty view, if the entry is in front of the first section
+     */
+    const StringView& section() const;
+    /**
+     * @brief Get the line of the entry returned last
+     * @returns The line number, starting with 1
+     */
+    size_t line() const;
+};
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,256 @@
+/**
+ * @file convert.cpp
+ * @brief A file that defines the conversion of parameters to numbers
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include <cctype>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "convert.hpp"
+#include "exceptions.hpp"
+
+
+namespace cmdlinecpp {
+namespace convert {
+
+
+namespace {
+
+/**
+ * @brief Value of every character as a digit. 0xff marks characters that are no digit in any base.
+ */
+const unsigned char digit_values[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0,    1,    2,    3,    4,    5,    6,    7,    8,    9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff,   10,   11,   12,   13,   14,   15, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff,   10,   11,   12,   13,   14,   15, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+
+/**
+ * @brief Parse the digits of a number without sign
+ * @param begin The first character after the sign
+ * @param end Behind the last character
+ * @param max The biggest magnitude allowed
+ * @param value Is set to the magnitude
+ * @returns False on a syntax error or if the magnitude is greater than max
+ */
+bool parse_magnitude( const char* begin, const char* end, uint64_t max, uint64_t& value ) {
+    unsigned int base = 10;
+    if ( end - begin > 2 && begin[0] == '0' ) {
+        switch ( begin[1] ) {
+            case 'x': case 'X': base = 16; begin += 2; break;
+            case 'o': case 'O': base = 8; begin += 2; break;
+            case 'b': case 'B': base = 2; begin += 2; break;
+            default: break;
+        }
+    }
+    if ( begin == end ) {
+        return false;
+    }
+
+    // The same cut-off test as strtoul: value * base + digit <= max
+    const uint64_t cutoff = max / base;
+    const unsigned int cutlim = static_cast< unsigned int >( max % base );
+
+    uint64_t result = 0;
+    for ( const char* c = begin; c != end; c++ ) {
+        const unsigned int digit = digit_values[ static_cast< unsigned char >( *c ) ];
+        if ( digit >= base ) {
+            return false;
+        }
+        if ( result > cutoff || ( result == cutoff && digit > cutlim ) ) {
+            return false;
+        }
+        result = result * base + digit;
+    }
+
+    value = result;
+    return true;
+}
+
+
+template< typename T >
+T to_unsigned( const StringView& text, const char* type_name ) {
+    uint64_t value = 0;
+    if ( !parse_unsigned( text, std::numeric_limits< T >::max(), value ) ) {
+        throw exceptions::TypeError("Expected " + std::string(type_name) + " as data type, but '" + text.str() + "' is no valid " + type_name + ".");
+    }
+    return static_cast< T >( value );
+}
+
+
+template< typename T >
+T to_signed( const StringView& text, const char* type_name ) {
+    int64_t value = 0;
+    if ( !parse_signed( text, std::numeric_limits< T >::min(), std::numeric_limits< T >::max(), value ) ) {
+        throw exceptions::TypeError("Expected " + std::string(type_name) + " as data type, but '" + text.str() + "' is no valid " + type_name + ".");
+    }
+    return static_cast< T >( value );
+}
+
+} // namespace
+
+
+bool parse_unsigned( const StringView& text, uint64_t max, uint64_t& value ) {
+    const char* begin = text.begin();
+    if ( begin != text.end() && *begin == '+' ) {
+        ++begin;
+    }
+
+    return parse_magnitude( begin, text.end(), max, value );
+}
+
+
+bool parse_signed( const StringView& text, int64_t min, int64_t max, int64_t& value ) {
+    const char* begin = text.begin();
+    bool negative = false;
+    if ( begin != text.end() && ( *begin == '+' || *begin == '-' ) ) {
+        negative = ( *begin == '-' );
+        ++begin;
+    }
+
+    // The magnitude of min may not fit into int64_t, so it is computed unsigned
+    const uint64_t limit = negative ? static_cast< uint64_t >( -( min + 1 ) ) + 1
+                                    : static_cast< uint64_t >( max );
+    uint64_t magnitude = 0;
+    if ( !parse_magnitude( begin, text.end(), limit, magnitude ) ) {
+        return false;
+    }
+
+    if ( negative ) {
+        value = magnitude == 0 ? 0 : -static_cast< int64_t >( magnitude - 1 ) - 1;
+    } else {
+        value = static_cast< int64_t >( magnitude );
+    }
+    return true;
+}
+
+
+long to_long( const StringView& text ) {
+    return to_signed< long >( text, "long" );
+}
+
+
+int to_int( const StringView& text ) {
+    return to_signed< int >( text, "int" );
+}
+
+
+short to_short( const StringView& text ) {
+    return to_signed< short >( text, "short" );
+}
+
+
+unsigned long to_unsigned_long( const StringView& text ) {
+    return to_unsigned< unsigned long >( text, "unsigned long" );
+}
+
+
+unsigned int to_unsigned_int( const StringView& text ) {
+    return to_unsigned< unsigned int >( text, "unsigned int" );
+}
+
+
+unsigned short to_unsigned_short( const StringView& text ) {
+    return to_unsigned< unsigned short >( text, "unsigned short" );
+}
+
+
+double to_double( const StringView& text ) {
+    // Only a decimal number counts, like for the stream, so no hexadecimal numbers, inf or nan
+    size_t begin = 0;
+    while ( begin < text.length() && std::isspace( static_cast< unsigned char >( text[begin] ) ) ) {
+        ++begin;
+    }
+    size_t end = begin;
+    if ( end < text.length() && ( text[end] == '+' || text[end] == '-' ) ) {
+        ++end;
+    }
+    while ( end < text.length() && ( digit_values[ static_cast< unsigned char >( text[end] ) ] < 10 || text[end] == '.' ) ) {
+        ++end;
+    }
+    if ( end < text.length() && ( text[end] == 'e' || text[end] == 'E' ) ) {
+        ++end;
+        if ( end < text.length() && ( text[end] == '+' || text[end] == '-' ) ) {
+            ++end;
+        }
+        const size_t exponent = end;
+        while ( end < text.length() && digit_values[ static_cast< unsigned char >( text[end] ) ] < 10 ) {
+            ++end;
+        }
+        if ( end == exponent ) {
+            // The stream fails on an exponent without digits
+            return 0;
+        }
+    }
+
+    // strtod needs a terminated string and reads the decimal point of the C locale
+    char buffer[64];
+    std::string long_number;
+    char* number = buffer;
+    if ( end - begin < sizeof( buffer ) ) {
+        std::memcpy( buffer, text.data() + begin, end - begin );
+        buffer[ end - begin ] = '\0';
+    } else {
+        long_number = text.substr( begin, end - begin ).str();
+        number = &long_number[0];
+    }
+
+    const char decimal_point = *std::localeconv()->decimal_point;
+    if ( decimal_point != '.' ) {
+        char* point = std::strchr( number, '.' );
+        if ( point != nullptr ) {
+            *point = decimal_point;
+        }
+    }
+
+    errno = 0;
+    const double value = std::strtod( number, nullptr );
+    if ( errno == ERANGE && std::isinf( value ) ) {
+        return value > 0 ? std::numeric_limits< double >::max() : -std::numeric_limits< double >::max();
+    }
+    return value;
+}
+
+
+} // namespace convert
+} // namespace cmdlinecpp
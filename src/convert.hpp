@@ -0,0 +1,108 @@
+/**
+ * @file convert.hpp
+ * @brief A file that defines the conversion of parameters to numbers
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include "stringview.hpp"
+
+#include <cstdint>
+
+
+namespace cmdlinecpp {
+namespace convert {
+
+
+/**
+ * @brief Parse an unsigned integer with an upper limit
+ * @param text The text to parse. An optional '+' and a base prefix (0x, 0o, 0b) are accepted, whitespace is not.
+ * @param max The biggest value allowed
+ * @param value Is set to the parsed value on success
+ * @returns False, if text is no valid number in this notation or the number is greater than max
+ * @note This does not allocate and does not depend on the locale. A leading 0 without a letter does not select octal.
+ */
+bool parse_unsigned( const StringView& text, uint64_t max, uint64_t& value );
+/**
+ * @brief Parse a signed integer within limits
+ * @param text The text to parse. An optional sign and a base prefix (0x, 0o, 0b) are accepted, whitespace is not.
+ * @param min The smallest value allowed
+ * @param max The biggest value allowed
+ * @param value Is set to the parsed value on success
+ * @returns False, if text is no valid number in this notation or the number is not within min and max
+ */
+bool parse_signed( const StringView& text, int64_t min, int64_t max, int64_t& value );
+
+/**
+ * @brief Convert a parameter to long
+ * @param text The parameter
+ * @returns The value of the parameter
+ * @throws TypeError If text is no integer or out of range for long
+ */
+long to_long( const StringView& text );
+/**
+ * @brief Convert a parameter to int
+ * @param text The parameter
+ * @returns The value of the parameter
+ * @throws TypeError If text is no integer or out of range for int
+ */
+int to_int( const StringView& text );
+/**
+ * @brief Convert a parameter to short
+ * @param text The parameter
+ * @returns The value of the parameter
+ * @throws TypeError If text is no integer or out of range for short
+ */
+short to_short( const StringView& text );
+/**
+ * @brief Convert a parameter to unsigned long
+ * @param text The parameter
+ * @returns The value of the parameter
+ * @throws TypeError If text is no unsigned integer or out of range for unsigned long
+ */
+unsigned long to_unsigned_long( const StringView& text );
+/**
+ * @brief Convert a parameter to unsigned int
+ * @param text The parameter
+ * @returns The value of the parameter
+ * @throws TypeError If text is no unsigned integer or out of range for unsigned int
+ */
+unsigned int to_unsigned_int( const StringView& text );
+/**
+ * @brief Convert a parameter to unsigned short
+ * @param text The parameter
+ * @returns The value of the parameter
+ * @throws TypeError If text is no unsigned integer or out of range for unsigned short
+ */
+unsigned short to_unsigned_short( const StringView& text );
+/**
+ * @brief Convert a parameter to double, like reading it from a std::istringstream did
+ * @param text The parameter. Leading whitespace is skipped and the number ends at the first character that does not belong to it.
+ * @returns The value of the parameter, 0 if it does not start with a number, or the biggest double with the sign of the parameter, if it is out of range
+ * @note This does not allocate for parameters up to 63 characters and always reads '.' as decimal point, whatever the locale is.
+ */
+double to_double( const StringView& text );
+
+
+} // namespace convert
+} // namespace cmdlinecpp
@@ -22,6 +22,7 @@
 #include "config.hpp"
 
 #include "cmdline.hpp"
+#include "exceptions.hpp"
 
 #include <iostream>
 
@@ -52,6 +53,10 @@ int main( int argc, char** argv ) {
     // Parse the parameters passed to main.
     try {
         if ( !cmdline.parse() ) {
+            if ( cmdline.completion_requested() ) {
+                // The shell asked for completions, they are printed already
+                return 0;
+            }
             // This happens, when there are no parameters to parse
             cmdline.print_help();
             // As an alternative you can specify the program's default behavior without options here.
@@ -63,6 +68,10 @@ int main( int argc, char** argv ) {
         std::cerr << "ERROR: " << oor.what() << std::endl;
         cmdline.print_help();
         return 1;
+    } catch ( cmdlinecpp::exceptions::TypeError& te ) {
+        // This happens, when a parameter is no valid value of its option's type, e.g. "-n abc" or an overflowing number
+        std::cerr << "ERROR: " << te.what() << std::endl;
+        return 1;
     }
     
     // If the help option is specified, this function will print the help and exit with 0
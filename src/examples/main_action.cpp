@@ -43,6 +43,10 @@ int main( int argc, char** argv ) {
     // Parse the parameters passed to main.
     try {
         if ( !cmdline.parse( argc, argv ) ) { // Alternative definition of CmdLineParser::parse
+            if ( cmdline.completion_requested() ) {
+                // The shell asked for completions, they are printed already
+                return 0;
+            }
             // This happens, when there are no parameters to parse
             cmdline.print_help();
             // As an alternative you can specify the program's default behavior without options here.
@@ -0,0 +1,299 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+
+#include "config.hpp"
+
+#include "cmdline.hpp"
+#include "staticschema.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+
+// Guards the paths that must not allocate: parsing again with frozen definitions and a warm arena,
+// reading the parsed values, and parsing and reading with a static schema. The parses alternate
+// between two different command lines, so the values read afterwards must be the ones of the last.
+// Only allocations through operator new and new[] are counted. Calls to malloc or posix_memalign
+// are not seen, the library uses the latter only for arena chunks with an alignment above
+// alignof( std::max_align_t ).
+// Exits with 1 and names the path, if one of them allocates.
+
+namespace {
+
+size_t allocations = 0;
+
+constexpr cmdlinecpp::StaticOption static_options[] = {
+    cmdlinecpp::StaticOption( "verbose", "v", "Print more.", cmdlinecpp::Data::Type::Bool ),
+    cmdlinecpp::StaticOption( "ratio", "r", "A ratio.", cmdlinecpp::Data::Type::Double ),
+    cmdlinecpp::StaticOption( "offset", "o", "An offset.", cmdlinecpp::Data::Type::Long ),
+    cmdlinecpp::StaticOption( "iterations", "n", "The number of iterations.", cmdlinecpp::Data::Type::Int ),
+    cmdlinecpp::StaticOption( "level", "l", "A level.", cmdlinecpp::Data::Type::Short ),
+    cmdlinecpp::StaticOption( "include-directory", "I", "A directory to include.", cmdlinecpp::Data::Type::String ),
+    cmdlinecpp::StaticOption( "maximum-file-size", "m", "The largest file.", cmdlinecpp::Data::Type::UnsignedLong ),
+    cmdlinecpp::StaticOption( "jobs", "j", "The number of jobs.", cmdlinecpp::Data::Type::UnsignedInt ),
+    cmdlinecpp::StaticOption( "port", "p", "The port.", cmdlinecpp::Data::Type::UnsignedShort ),
+    cmdlinecpp::StaticOption( "OUTPUT", "The output file." ),
+    cmdlinecpp::StaticOption( "INPUTS", "The input files." )
+};
+
+constexpr cmdlinecpp::StaticAction static_actions[] = {
+    cmdlinecpp::StaticAction( "build", "Build the targets." ),
+    cmdlinecpp::StaticAction( "clean", "Remove the build outputs." )
+};
+
+constexpr auto static_schema = cmdlinecpp::make_static_schema( static_options, static_actions );
+
+
+void* counted_allocation( std::size_t size ) {
+    ++allocations;
+    void* memory = std::malloc( size > 0 ? size : 1 );
+    if ( memory == nullptr ) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+
+/**
+ * @brief Run a path and report, if it allocated
+ * @returns True, if the path did not allocate
+ */
+template< typename F >
+bool expect_no_allocations( const char* path, F run ) {
+    const size_t before = allocations;
+    run();
+    const size_t count = allocations - before;
+    if ( count > 0 ) {
+        std::cerr << "FAILED: " << path << " allocated " << count << " times" << std::endl;
+        return false;
+    }
+    std::cout << "ok: " << path << std::endl;
+    return true;
+}
+
+
+/**
+ * @brief Report, if the values read after a parse are wrong
+ * @returns The result
+ */
+bool expect_values( const char* name, bool result ) {
+    if ( !result ) {
+        std::cerr << "FAILED: " << name << std::endl;
+        return false;
+    }
+    std::cout << "ok: " << name << std::endl;
+    return true;
+}
+
+} // namespace
+
+
+void* operator new( std::size_t size ) {
+    return counted_allocation( size );
+}
+
+
+void* operator new[]( std::size_t size ) {
+    return counted_allocation( size );
+}
+
+
+void operator delete( void* memory ) noexcept {
+    std::free( memory );
+}
+
+
+void operator delete[]( void* memory ) noexcept {
+    std::free( memory );
+}
+
+
+void operator delete( void* memory, std::size_t ) noexcept {
+    std::free( memory );
+}
+
+
+void operator delete[]( void* memory, std::size_t ) noexcept {
+    std::free( memory );
+}
+
+
+int main() {
+    cmdlinecpp::Parser parser;
+    parser << cmdlinecpp::Action( "build", "Build the targets." );
+    parser << cmdlinecpp::Action( "clean", "Remove the build outputs." );
+    parser << cmdlinecpp::Option( "verbose", "v", "Print more.", cmdlinecpp::Data::Type::Bool );
+    parser << cmdlinecpp::Option( "ratio", "r", "A ratio.", cmdlinecpp::Data::Type::Double );
+    parser << cmdlinecpp::Option( "offset", "o", "An offset.", cmdlinecpp::Data::Type::Long );
+    parser << cmdlinecpp::Option( "iterations", "n", "The number of iterations.", cmdlinecpp::Data::Type::Int );
+    parser << cmdlinecpp::Option( "level", "l", "A level.", cmdlinecpp::Data::Type::Short );
+    parser << cmdlinecpp::Option( "include-directory", "I", "A directory to include.", cmdlinecpp::Data::Type::String );
+    parser << cmdlinecpp::Option( "maximum-file-size", "m", "The largest file.", cmdlinecpp::Data::Type::UnsignedLong );
+    parser << cmdlinecpp::Option( "jobs", "j", "The number of jobs.", cmdlinecpp::Data::Type::UnsignedInt );
+    parser << cmdlinecpp::Option( "port", "p", "The port.", cmdlinecpp::Data::Type::UnsignedShort );
+    parser << cmdlinecpp::Option( "OUTPUT", "The output file." );
+    parser << cmdlinecpp::Option( "INPUTS", "The input files." );
+
+    const char* parameters[] = {
+        "allocations", "build", "-v", "--ratio", "0.75", "-o", "-123456789", "--iterations", "42", "-l", "-7",
+        "-I", "/usr/local/include/with/a/long/path", "--include-directory", "/opt/include",
+        "--maximum-file-size", "4294967296", "-j", "8", "--port", "8080",
+        "/tmp/output-file-with-a-long-name.dat", "input-1.dat", "input-2.dat", "input-3.dat"
+    };
+    const int count = sizeof( parameters ) / sizeof( parameters[0] );
+    char** argv = const_cast< char** >( parameters );
+
+    const char* other_parameters[] = {
+        "allocations", "clean", "-n", "7", "-I", "/srv/include", "/tmp/other.dat", "other-input.dat"
+    };
+    const int other_count = sizeof( other_parameters ) / sizeof( other_parameters[0] );
+    char** other_argv = const_cast< char** >( other_parameters );
+
+    // The first parse freezes the definitions, the second one merges the chunks the arena grew into
+    parser.parse( count, argv );
+    parser.parse( count, argv );
+
+    bool ok = true;
+    ok = expect_no_allocations( "parse with frozen definitions", [&]() {
+        for ( int r = 0; r < 100; r++ ) {
+            if ( r % 2 == 0 ) {
+                parser.parse( count, argv );
+            } else {
+                parser.parse( other_count, other_argv );
+            }
+        }
+    } ) && ok;
+
+    // The last parse was the other command line, nothing of the first may remain
+    ok = expect_values( "values of the last command line",
+                        parser.get_selected_action() == "clean" && !parser.value( parser.option_id( "verbose" ) ).as_bool
+                     && !parser.is_specified( "ratio" ) && !parser.is_specified( "port" )
+                     && parser.value( parser.option_id( "iterations" ) ).as_int == 7
+                     && parser.occurrences( "include-directory" ).size() == 1 && parser.view( "include-directory" ) == "/srv/include"
+                     && parser.view( "OUTPUT" ) == "/tmp/other.dat" && parser.last_positionals().size() == 1 ) && ok;
+
+    ok = expect_no_allocations( "parse the first command line again", [&]() {
+        parser.parse( count, argv );
+    } ) && ok;
+
+    bool verbose = false;
+    double ratio = 0;
+    long offset = 0;
+    int iterations = 0;
+    short level = 0;
+    cmdlinecpp::StringView include;
+    unsigned long maximum = 0;
+    unsigned int jobs = 0;
+    unsigned short port = 0;
+    cmdlinecpp::StringView output;
+    ok = expect_no_allocations( "to_variable", [&]() {
+        parser.to_variable( "verbose", verbose );
+        parser.to_variable( "ratio", ratio );
+        parser.to_variable( "offset", offset );
+        parser.to_variable( "iterations", iterations );
+        parser.to_variable( "level", level );
+        parser.to_variable( "include-directory", include );
+        parser.to_variable( "maximum-file-size", maximum );
+        parser.to_variable( "jobs", jobs );
+        parser.to_variable( "port", port );
+        parser.to_variable( "OUTPUT", output );
+    } ) && ok;
+
+    const cmdlinecpp::Data include_data( "include-directory" );
+    // The parser keeps a copy of the requested Data, so only the first request may size it
+    parser >> include_data >> include;
+    ok = expect_no_allocations( "operator>> with a kept Data", [&]() {
+        parser >> include_data >> include;
+    } ) && ok;
+
+    size_t includes = 0;
+    size_t inputs = 0;
+    bool specified = false;
+    ok = expect_no_allocations( "is_specified, value and occurrences", [&]() {
+        specified = parser.is_specified( "maximum-file-size" ) && parser.is_specified( "verbose" );
+        iterations = parser.value( parser.option_id( "iterations" ) ).as_int;
+        cmdlinecpp::Occurrences occurrences = parser.occurrences( "include-directory" );
+        for ( const cmdlinecpp::Value* value = occurrences.begin(); value != occurrences.end(); ++value ) {
+            includes += value->text.length();
+        }
+        inputs = parser.last_positionals().size();
+    } ) && ok;
+
+    // The values have to be right, too, or the paths above tested nothing
+    ok = ok && verbose && ratio == 0.75 && offset == -123456789 && iterations == 42 && level == -7
+       && include == "/opt/include" && maximum == 4294967296ul && jobs == 8 && port == 8080
+       && output == "/tmp/output-file-with-a-long-name.dat" && specified
+       && includes == std::string( "/usr/local/include/with/a/long/path/opt/include" ).length() && inputs == 3;
+
+    auto static_parameters = cmdlinecpp::make_static_parameters( static_schema );
+    ok = expect_no_allocations( "parse with a static schema", [&]() {
+        for ( int r = 0; r < 100; r++ ) {
+            if ( r % 2 == 0 ) {
+                static_parameters.parse( count, argv );
+            } else {
+                static_parameters.parse( other_count, other_argv );
+            }
+        }
+    } ) && ok;
+
+    ok = expect_values( "static values of the last command line",
+                        static_parameters.action() == static_schema.action_id( "clean" )
+                     && !static_parameters.get_bool( static_schema.id( "verbose" ) )
+                     && !static_parameters.is_specified( static_schema.id( "ratio" ) )
+                     && static_parameters.get_int( static_schema.id( "iterations" ) ) == 7
+                     && static_parameters.get_string( static_schema.id( "include-directory" ) ) == "/srv/include"
+                     && static_parameters.get_string( static_schema.id( "OUTPUT" ) ) == "/tmp/other.dat"
+                     && static_parameters.last_positionals_count() == 1 ) && ok;
+
+    ok = expect_no_allocations( "parse the first command line again with a static schema", [&]() {
+        static_parameters.parse( count, argv );
+    } ) && ok;
+
+    ratio = 0;
+    ok = expect_no_allocations( "StaticParameters reads", [&]() {
+        verbose = static_parameters.get_bool( static_schema.id( "verbose" ) );
+        ratio = static_parameters.get_double( static_schema.id( "ratio" ) );
+        offset = static_parameters.get_long( static_schema.id( "offset" ) );
+        iterations = static_parameters.get_int( static_schema.id( "iterations" ) );
+        level = static_parameters.get_short( static_schema.id( "level" ) );
+        include = static_parameters.get_string( static_schema.id( "include-directory" ) );
+        maximum = static_parameters.get_unsigned_long( static_schema.id( "maximum-file-size" ) );
+        jobs = static_parameters.get_unsigned_int( static_schema.id( "jobs" ) );
+        port = static_parameters.get_unsigned_short( static_schema.id( "port" ) );
+        output = static_parameters.get_string( static_schema.id( "OUTPUT" ) );
+        specified = static_parameters.is_specified( static_schema.id( "maximum-file-size" ) );
+        inputs = static_parameters.last_positionals_count();
+    } ) && ok;
+
+    ok = ok && verbose && ratio == 0.75 && offset == -123456789 && iterations == 42 && level == -7
+       && include == "/opt/include" && maximum == 4294967296ul && jobs == 8 && port == 8080
+       && output == "/tmp/output-file-with-a-long-name.dat" && specified && inputs == 3
+       && static_parameters.action() == static_schema.action_id( "build" );
+    if ( !ok ) {
+        std::cerr << "FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "cmdline.hpp"
+
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Checks the shell completion: a Parser answers completion requests only when they are enabled and
+// returns to the caller instead of exiting, the completions are found by prefix and the scripts ask
+// the program only when it answers.
+// Exits with 1 and names the case, if one of them fails.
+
+namespace {
+
+void define( cmdlinecpp::Parser& parser ) {
+    parser << cmdlinecpp::Action( "build", "Build the targets." );
+    parser << cmdlinecpp::Action( "bench", "Run the benchmarks." );
+    parser << cmdlinecpp::Action( "clean", "Remove the build outputs." );
+    parser << cmdlinecpp::Option( "verbose", "v", "Print more.", cmdlinecpp::Data::Type::Bool );
+    parser << cmdlinecpp::Option( "version", "V", "Print the version.", cmdlinecpp::Data::Type::Bool );
+    parser << cmdlinecpp::Option( "output", "o", "The output file.", cmdlinecpp::Data::Type::String );
+    parser << cmdlinecpp::Option( "jobs", "j", "The number of jobs.", cmdlinecpp::Data::Type::Int );
+}
+
+
+/**
+ * @brief Parse a command line with a new parser
+ * @returns "completion", "parsed" or the error message
+ */
+std::string parse( bool enabled, std::initializer_list< const char* > parameters ) {
+    cmdlinecpp::Parser parser;
+    define( parser );
+    parser.set_completion_requests_enabled( enabled );
+
+    std::vector< char* > argv( 1, const_cast< char* >( "cmdlinecpp_test_completion" ) );
+    for ( const char* parameter : parameters ) {
+        argv.push_back( const_cast< char* >( parameter ) );
+    }
+
+    try {
+        const bool parsed = parser.parse( static_cast< int >( argv.size() ), argv.data() );
+        if ( parser.completion_requested() ) {
+            return parsed ? "error: parsed a completion request" : "completion";
+        }
+        return parsed ? "parsed" : "error: not parsed";
+    } catch ( std::exception& e ) {
+        return std::string( "error: " ) + e.what();
+    }
+}
+
+
+/**
+ * @brief Complete the last word of a command line
+ * @returns The completions, one per line
+ */
+std::string complete( std::initializer_list< const char* > words ) {
+    cmdlinecpp::Parser parser;
+    define( parser );
+
+    std::vector< cmdlinecpp::StringView > views;
+    for ( const char* word : words ) {
+        views.push_back( cmdlinecpp::StringView( word ) );
+    }
+    std::string completions;
+    cmdlinecpp::Completion::complete( parser.arguments(), views.data(), views.size(), views.size() - 1, completions );
+    return completions;
+}
+
+
+bool expect( const char* name, const std::string& result, const std::string& expected ) {
+    if ( result != expected ) {
+        std::cerr << "FAILED: " << name << " gave '" << result << "' instead of '" << expected << "'" << std::endl;
+        return false;
+    }
+    std::cout << "ok: " << name << std::endl;
+    return true;
+}
+
+} // namespace
+
+
+int main() {
+    bool ok = true;
+    ok = expect( "a Parser parses a completion request like other parameters"
+               , parse( false, { "--cmdlinecpp-complete", "1", "prog", "x" } )
+               , "error: Unknown option '--cmdlinecpp-complete'." ) && ok;
+    ok = expect( "an enabled Parser answers and returns"
+               , parse( true, { "--cmdlinecpp-complete", "1", "prog", "x" } ), "completion" ) && ok;
+    ok = expect( "a word index that is no number returns, too"
+               , parse( true, { "--cmdlinecpp-complete", "one", "prog" } ), "completion" ) && ok;
+    ok = expect( "an enabled Parser still parses other command lines", parse( true, { "-v", "build" } ), "parsed" ) && ok;
+
+    ok = expect( "long options by prefix", complete( { "prog", "--ver" } ), "--verbose\n--version\n" ) && ok;
+    ok = expect( "short options by prefix", complete( { "prog", "-V" } ), "-V\n" ) && ok;
+    ok = expect( "a dash completes all options", complete( { "prog", "-" } )
+               , "--help\n--jobs\n--output\n--verbose\n--version\n-V\n-h\n-j\n-o\n-v\n" ) && ok;
+    ok = expect( "actions by prefix", complete( { "prog", "b" } ), "bench\nbuild\n" ) && ok;
+    ok = expect( "no second action", complete( { "prog", "build", "b" } ), "" ) && ok;
+    ok = expect( "no names for a value", complete( { "prog", "--jobs", "" } ), "" ) && ok;
+
+    cmdlinecpp::Parser parser;
+    define( parser );
+    parser.set_program_name( "prog" );
+    const cmdlinecpp::Completion::Shell shells[] = {
+        cmdlinecpp::Completion::Shell::Bash, cmdlinecpp::Completion::Shell::Zsh, cmdlinecpp::Completion::Shell::Fish
+    };
+    for ( cmdlinecpp::Completion::Shell shell : shells ) {
+        ok = expect( "a static script does not run the program"
+                   , parser.completion_script( shell ).find( COMPLETION_REQUEST ) == std::string::npos ? "static" : "asks"
+                   , "static" ) && ok;
+    }
+    parser.set_completion_requests_enabled( true );
+    for ( cmdlinecpp::Completion::Shell shell : shells ) {
+        ok = expect( "the script asks a program that answers"
+                   , parser.completion_script( shell ).find( COMPLETION_REQUEST ) == std::string::npos ? "static" : "asks"
+                   , "asks" ) && ok;
+    }
+
+    if ( !ok ) {
+        std::cerr << "FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "cmdline.hpp"
+
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Checks how parameters are assigned to positional arguments: the last positional list starts with
+// the value of the last positional argument and takes every parameter behind it. A parameter with a
+// leading '-' that names no option is positional, like a file -x.txt, while a positional slot is free.
+// With unknown options rejected it is reported as unknown option instead, unless it is a lone "-",
+// a negative number or stands behind --. A list set from a vector of views
+// stays valid, when the vector is gone.
+// Exits with 1 and names the case, if one of them fails.
+
+namespace {
+
+/**
+ * @brief Parse a command line with a positional OUTPUT and a last positional INPUTS
+ * @param rejected If true, unknown options are rejected in place of positional arguments
+ * @returns OUTPUT and the last positional list joined by spaces, or the error message
+ */
+std::string parse( std::initializer_list< const char* > parameters, bool rejected ) {
+    cmdlinecpp::Parser parser;
+    parser << cmdlinecpp::Option( "verbose", "v", "Print more.", cmdlinecpp::Data::Type::Bool );
+    parser << cmdlinecpp::Option( "OUTPUT", "The output file." );
+    parser << cmdlinecpp::Option( "INPUTS", "The input files." );
+    parser.set_unknown_options_rejected( rejected );
+
+    std::vector< char* > argv( 1, const_cast< char* >( "cmdlinecpp_test_positionals" ) );
+    for ( const char* parameter : parameters ) {
+        argv.push_back( const_cast< char* >( parameter ) );
+    }
+
+    try {
+        parser.parse( static_cast< int >( argv.size() ), argv.data() );
+    } catch ( std::exception& e ) {
+        return std::string( "error: " ) + e.what();
+    }
+
+    std::string list = parser["OUTPUT"] + ":";
+    const std::vector< std::string > items = parser.get_last_positionals_as_list();
+    for ( size_t i = 0; i < items.size(); i++ ) {
+        list += " " + items[i];
+    }
+    if ( items.size() != parser.last_positionals().size() ) {
+        return "error: the list and the slice differ";
+    }
+    return list;
+}
+
+
+bool expect( const char* name, bool result ) {
+    if ( !result ) {
+        std::cerr << "FAILED: " << name << std::endl;
+        return false;
+    }
+    std::cout << "ok: " << name << std::endl;
+    return true;
+}
+
+
+bool expect( const char* name, std::initializer_list< const char* > parameters, const std::string& expected
+           , bool rejected = false ) {
+    const std::string result = parse( parameters, rejected );
+    if ( result != expected ) {
+        std::cerr << "FAILED: " << name << " gave '" << result << "' instead of '" << expected << "'" << std::endl;
+        return false;
+    }
+    std::cout << "ok: " << name << std::endl;
+    return true;
+}
+
+} // namespace
+
+
+int main() {
+    bool ok = true;
+    ok = expect( "a single value is the whole list", { "out", "a" }, "out: a" ) && ok;
+    ok = expect( "the list starts with the value of the last positional", { "out", "a", "b", "c" }, "out: a b c" ) && ok;
+    ok = expect( "options before the list are no items", { "-v", "out", "a", "b" }, "out: a b" ) && ok;
+    ok = expect( "parameters behind -- are items", { "out", "--", "-v", "b" }, "out: -v b" ) && ok;
+    ok = expect( "a missing list is an error", { "out" }, "error: Not all positional arguments are specified." ) && ok;
+    ok = expect( "a dashed file is positional", { "-x.txt", "a" }, "-x.txt: a" ) && ok;
+    ok = expect( "a dashed file is a list item", { "out", "-x.txt", "-y" }, "out: -x.txt -y" ) && ok;
+
+    ok = expect( "a rejected unknown option is no positional", { "--verbos", "out", "a" },
+                 "error: Unknown option '--verbos'. Did you mean '--verbose'?", true ) && ok;
+    ok = expect( "a rejected unknown option is no list item", { "out", "-x" },
+                 "error: Unknown option '-x'. Did you mean '-h' or '-v'?", true ) && ok;
+    ok = expect( "a dashed file is rejected, too", { "-x.txt", "a" }, "error: Unknown option '-x.txt'.", true ) && ok;
+    ok = expect( "a negative number is positional", { "out", "-5" }, "out: -5", true ) && ok;
+    ok = expect( "a lone - is positional", { "out", "-" }, "out: -", true ) && ok;
+    ok = expect( "an unknown option behind -- is an item", { "out", "--", "--verbos" }, "out: --verbos", true ) && ok;
+
+    cmdlinecpp::CmdLineParameters parameters;
+    {
+        std::vector< cmdlinecpp::StringView > items = { "a", "b" };
+        parameters.set_last_positionals( items );
+        items[1] = cmdlinecpp::StringView( "x" );
+    }
+    ok = expect( "a list set from a vector is copied",
+                 parameters.last_positionals().size() == 2 && parameters.last_positionals()[1] == "b" ) && ok;
+
+    if ( !ok ) {
+        std::cerr << "FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
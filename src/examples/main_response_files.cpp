@@ -0,0 +1,98 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "cmdline.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+// Checks the expansion of response files: @file is replaced by the parameters in the file, but an
+// @ parameter that names no regular, readable file is kept as it is, like gcc does. A Parser expands
+// them only when they are enabled.
+// Exits with 1 and names the case, if one of them fails.
+
+namespace {
+
+const char* const response_file = "cmdlinecpp_test_response_files.rsp";
+
+
+/**
+ * @brief Parse a command line with a positional TARGET and an option --jobs
+ * @param enabled If true, response files are expanded
+ * @returns The value of TARGET or the error message
+ */
+std::string parse( const std::string& parameter, bool enabled ) {
+    cmdlinecpp::Parser parser;
+    parser << cmdlinecpp::Option( "jobs", "j", "The number of jobs.", cmdlinecpp::Data::Type::Int );
+    parser << cmdlinecpp::Option( "TARGET", "The target." );
+    if ( enabled ) {
+        parser.set_response_files_enabled( true );
+    }
+
+    const char* parameters[] = { "cmdlinecpp_test_response_files", parameter.c_str() };
+    try {
+        parser.parse( 2, const_cast< char** >( parameters ) );
+        return parser["TARGET"] + ( parser.is_specified( "jobs" ) ? " with jobs" : "" );
+    } catch ( std::exception& e ) {
+        return std::string( "error: " ) + e.what();
+    }
+}
+
+
+bool expect( const char* name, const std::string& parameter, const std::string& expected, bool enabled = true ) {
+    const std::string result = parse( parameter, enabled );
+    if ( result != expected ) {
+        std::cerr << "FAILED: " << name << " gave '" << result << "' instead of '" << expected << "'" << std::endl;
+        return false;
+    }
+    std::cout << "ok: " << name << std::endl;
+    return true;
+}
+
+} // namespace
+
+
+int main() {
+    {
+        std::ofstream file( response_file );
+        file << "--jobs 4\nall\n";
+    }
+
+    bool ok = true;
+    ok = expect( "a response file is expanded", std::string( "@" ) + response_file, "all with jobs" ) && ok;
+    ok = expect( "a directory is kept", "@.", "@." ) && ok;
+    ok = expect( "a missing file is kept", "@cmdlinecpp-no-such-file", "@cmdlinecpp-no-such-file" ) && ok;
+    ok = expect( "a lone @ is kept", "@", "@" ) && ok;
+    ok = expect( "a Parser reads no response file by default"
+               , std::string( "@" ) + response_file, std::string( "@" ) + response_file, false ) && ok;
+
+    std::remove( response_file );
+    if ( !ok ) {
+        std::cerr << "FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
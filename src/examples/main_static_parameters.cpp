@@ -0,0 +1,89 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "staticschema.hpp"
+
+#include <iostream>
+
+
+// Checks that one StaticParameters object parses several command lines: nothing of the first
+// parse may remain in the results of the second one.
+// Exits with 1 and names the case, if one of them fails.
+
+namespace {
+
+constexpr cmdlinecpp::StaticOption options[] = {
+    cmdlinecpp::StaticOption( "verbose", "v", "Print more.", cmdlinecpp::Data::Type::Bool ),
+    cmdlinecpp::StaticOption( "iterations", "n", "The number of iterations.", cmdlinecpp::Data::Type::Int ),
+    cmdlinecpp::StaticOption( "PATH", "The path to the file to operate on." ),
+    cmdlinecpp::StaticOption( "FILES", "More files." )
+};
+
+constexpr cmdlinecpp::StaticAction actions[] = {
+    cmdlinecpp::StaticAction( "read", "Read the file." ),
+    cmdlinecpp::StaticAction( "write", "Write to the file." )
+};
+
+constexpr auto schema = cmdlinecpp::make_static_schema( options, actions );
+
+
+bool expect( const char* name, bool result ) {
+    if ( !result ) {
+        std::cerr << "FAILED: " << name << std::endl;
+        return false;
+    }
+    std::cout << "ok: " << name << std::endl;
+    return true;
+}
+
+} // namespace
+
+
+int main() {
+    auto parameters = cmdlinecpp::make_static_parameters( schema );
+
+    const char* first[] = { "static_parameters", "read", "-v", "-n", "5", "foo", "a", "b" };
+    const char* second[] = { "static_parameters", "bar", "c" };
+
+    bool ok = true;
+    parameters.parse( sizeof( first ) / sizeof( first[0] ), const_cast< char** >( first ) );
+    ok = expect( "the first parse sees all parameters",
+                 parameters.get_bool( schema.id( "verbose" ) ) && parameters.get_int( schema.id( "iterations" ) ) == 5
+              && parameters.action() == schema.action_id( "read" ) && parameters.get_string( schema.id( "PATH" ) ) == "foo"
+              && parameters.last_positionals_count() == 2 ) && ok;
+
+    parameters.parse( sizeof( second ) / sizeof( second[0] ), const_cast< char** >( second ) );
+    ok = expect( "options of the first parse are not given anymore",
+                 !parameters.get_bool( schema.id( "verbose" ) ) && !parameters.is_specified( schema.id( "iterations" ) ) ) && ok;
+    ok = expect( "the action of the first parse is not selected anymore",
+                 parameters.action() == cmdlinecpp::NameIndex::npos ) && ok;
+    ok = expect( "the positionals are the ones of the second parse",
+                 parameters.get_string( schema.id( "PATH" ) ) == "bar" && parameters.last_positionals_count() == 1
+              && parameters.last_positional( 0 ) == "c" ) && ok;
+
+    if ( !ok ) {
+        std::cerr << "FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include "staticschema.hpp"
+
+#include <iostream>
+
+
+// Define all options and actions as constant data. Nothing of this is built at runtime.
+static constexpr cmdlinecpp::StaticOption options[] = {
+    cmdlinecpp::StaticOption( "help", "h", "Print the help for this program", cmdlinecpp::Data::Type::Bool ),
+    cmdlinecpp::StaticOption( "iterations", "n", "The number of iterations the program makes.", cmdlinecpp::Data::Type::Int ),
+    cmdlinecpp::StaticOption( "PATH", "The path to the file to operate on." )
+};
+
+static constexpr cmdlinecpp::StaticAction actions[] = {
+    cmdlinecpp::StaticAction( "read", "Read the file." ),
+    cmdlinecpp::StaticAction( "write", "Write to the file." )
+};
+
+// The perfect hash tables are generated by the compiler and placed in read-only data.
+static constexpr auto schema = cmdlinecpp::make_static_schema( options, actions );
+
+// Option ids are constant expressions, too.
+static constexpr uint32_t OPTION_HELP = schema.id( "help" );
+static constexpr uint32_t OPTION_ITERATIONS = schema.id( "iterations" );
+static constexpr uint32_t OPTION_PATH = schema.id( "PATH" );
+static_assert( OPTION_ITERATIONS != cmdlinecpp::NameIndex::npos, "The option iterations is not defined." );
+
+
+int main( int argc, char** argv ) {
+
+    auto parameters = cmdlinecpp::make_static_parameters( schema );
+    
+    // Parse the parameters passed to main.
+    try {
+        if ( !parameters.parse( argc, argv ) ) {
+            return 1;
+        }
+    } catch ( std::out_of_range& oor ) {
+        std::cerr << "ERROR: " << oor.what() << std::endl;
+        return 1;
+    }
+    
+    if ( parameters.get_bool( OPTION_HELP ) ) {
+        for ( uint32_t id = 0; id < schema.option_count(); id++ ) {
+            std::cout << "\t" << schema.option( id ).name << "\t" << schema.option( id ).help_text << std::endl;
+        }
+        return 0;
+    }
+    
+    // ACCESS THE VALUES OF THE PARAMETERS BY THEIR IDS
+    cmdlinecpp::StringView path = parameters.get_string( OPTION_PATH );
+    
+    int n = 1;
+    if ( parameters.is_specified( OPTION_ITERATIONS ) ) {
+        n = parameters.get_int( OPTION_ITERATIONS );
+    }
+    
+    if ( parameters.action() != cmdlinecpp::NameIndex::npos ) {
+        std::cout << "Selected action: '" << schema.action( parameters.action() ).name << "'." << std::endl;
+    }
+    std::cout << "PATH: '" << path << "', iterations: " << n << std::endl;
+    
+    
+    return 0;
+}
@@ -35,5 +35,20 @@ TypeError::TypeError( const std::string& what_arg )
 {}
 
 
+ResponseFileError::ResponseFileError( const std::string& what_arg )
+    :   std::runtime_error( what_arg )
+{}
+
+
+ConfigFileError::ConfigFileError( const std::string& what_arg )
+    :   std::runtime_error( what_arg )
+{}
+
+
+SnapshotError::SnapshotError( const std::string& what_arg )
+    :   std::runtime_error( what_arg )
+{}
+
+
 } // namespace exceptions
 } // namespace cmdlinecpp
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <string>
 
 
 namespace cmdlinecpp {
@@ -36,7 +37,7 @@ namespace exceptions {
  * @brief This exception is to be thrown if a data type is wrong
  */
 class TypeError
-    :   std::logic_error
+    :   public std::logic_error
 {
 public:
     /**
@@ -47,5 +48,50 @@ public:
 };
 
 
+/**
+ * @brief This exception is to be thrown if a response file can not be expanded
+ */
+class ResponseFileError
+    :   public std::runtime_error
+{
+public:
+    /**
+     * @brief Constructor
+     * @param what_arg A string that describes, which response file failed and why
+     */
+    ResponseFileError( const std::string& what_arg );
+};
+
+
+/**
+ * @brief This exception is to be thrown if a config file can not be read
+ */
+class ConfigFileError
+    :   public std::runtime_error
+{
+public:
+    /**
+     * @brief Constructor
+     * @param what_arg A string that describes, which line of the config file failed and why
+     */
+    ConfigFileError( const std::string& what_arg );
+};
+
+
+/**
+ * @brief This exception is to be thrown if a snapshot of parameters can not be loaded
+ */
+class SnapshotError
+    :   public std::runtime_error
+{
+public:
+    /**
+     * @brief Constructor
+     * @param what_arg A string that describes, why the snapshot was refused
+     */
+    SnapshotError( const std::string& what_arg );
+};
+
+
 } // namespace exceptions
 } // namespace cmdlinecpp
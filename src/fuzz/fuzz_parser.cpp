@@ -0,0 +1,650 @@
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+
+#include "config.hpp"
+
+#include "cmdline.hpp"
+#include "completion.hpp"
+#include "exceptions.hpp"
+#include "index.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// Fuzzes the definition of a schema, the parse of a command line and the retrieval of the values.
+// An input is a text with one definition per line, an empty line and then one parameter per line:
+//     o <name> <short> [type]                a regular option, type is the digit of Data::Type
+//     e <name> <short> [type] <variable>     a regular option, that is read from an environment variable
+//     p <name> [type]                        a positional argument
+//     a <name>                               an action
+// Lines that are no definition are skipped, a missing type is String.
+//
+// Besides crashes the target flags superlinear behaviour: every input runs once as it is and once
+// with the schema and the command line repeated with renamed copies. The run counts its operations,
+// the allocations by operator new and the probes of the name indices, and aborts, if they grow much
+// faster than the input. The probes are only counted with CMDLINECPP_PARSE_STATS.
+//
+// Built with CMDLINECPP_LIBFUZZER this is a libFuzzer target. Otherwise it has its own main:
+//     cmdlinecpp_fuzz [-runs=N] [-seed=S] [file or directory]...
+// All files are run as they are, e.g. the regression corpus in src/fuzz/corpus. With -runs as many
+// inputs are generated, partly by mutating the files. Without arguments one input is read from stdin,
+// so the binary can be fuzzed by AFL as well.
+
+#if defined( __has_feature )
+#if __has_feature( address_sanitizer )
+#define FUZZ_SANITIZER_ALLOCATOR
+#endif
+#endif
+#ifdef __SANITIZE_ADDRESS__
+#define FUZZ_SANITIZER_ALLOCATOR
+#endif
+
+namespace {
+
+/**
+ * @brief The number of copies of the schema and the command line in the second run
+ */
+const size_t scale = 8;
+/**
+ * @brief How much faster than the input the operations may grow
+ */
+const uint64_t growth_slack = 2;
+/**
+ * @brief The operations of a run, that do not depend on the input, like the construction of the parser
+ */
+const uint64_t base_operations = 256;
+
+uint64_t allocations = 0;
+
+
+/**
+ * @brief Get the number of operations counted so far
+ */
+uint64_t operations() {
+    return allocations + cmdlinecpp::NameIndex::probes();
+}
+
+
+struct Definition {
+    char kind;
+    std::string name;
+    std::string short_name;
+    cmdlinecpp::Data::Type type;
+    std::string variable;
+};
+
+
+struct FuzzInput {
+    std::vector< Definition > definitions;
+    std::vector< std::string > parameters;
+};
+
+
+std::vector< std::string > split( const std::string& text, char separator ) {
+    std::vector< std::string > parts;
+    size_t begin = 0;
+    while ( true ) {
+        const size_t end = text.find( separator, begin );
+        if ( end == std::string::npos ) {
+            parts.push_back( text.substr( begin ) );
+            return parts;
+        }
+        parts.push_back( text.substr( begin, end - begin ) );
+        begin = end + 1;
+    }
+}
+
+
+cmdlinecpp::Data::Type decode_type( const std::vector< std::string >& fields, size_t index ) {
+    if ( index < fields.size() && fields[index].length() == 1 && fields[index][0] >= '0' && fields[index][0] <= '8' ) {
+        return static_cast< cmdlinecpp::Data::Type >( fields[index][0] - '0' );
+    }
+    return cmdlinecpp::Data::Type::String;
+}
+
+
+FuzzInput decode( const uint8_t* data, size_t size ) {
+    FuzzInput input;
+    const std::vector< std::string > lines = split( std::string( reinterpret_cast< const char* >( data ), size ), '\n' );
+
+    size_t l = 0;
+    for ( ; l < lines.size() && !lines[l].empty(); l++ ) {
+        const std::vector< std::string > fields = split( lines[l], ' ' );
+        if ( fields[0].length() != 1 || fields.size() < 2 ) {
+            continue;
+        }
+
+        Definition definition;
+        definition.kind = fields[0][0];
+        definition.name = fields[1];
+        definition.type = cmdlinecpp::Data::Type::String;
+        if ( definition.kind == 'o' || definition.kind == 'e' ) {
+            if ( fields.size() < 3 ) {
+                continue;
+            }
+            definition.short_name = fields[2];
+            definition.type = decode_type( fields, 3 );
+            if ( definition.kind == 'e' ) {
+                if ( fields.size() < 5 ) {
+                    continue;
+                }
+                definition.variable = fields[4];
+            }
+        } else if ( definition.kind == 'p' ) {
+            definition.type = decode_type( fields, 2 );
+        } else if ( definition.kind != 'a' ) {
+            continue;
+        }
+        input.definitions.push_back( definition );
+    }
+
+    if ( l < lines.size() ) {
+        input.parameters.assign( lines.begin() + l + 1, lines.end() );
+    }
+    return input;
+}
+
+
+/**
+ * @brief Repeat the schema and the command line
+ * @note The copies of the definitions get a suffix, and so do the long options in the copies of the command line.
+ *       Short specifiers are kept, so they clash with the first copy.
+ */
+FuzzInput repeat( const FuzzInput& input, size_t copies ) {
+    FuzzInput repeated;
+    repeated.definitions.reserve( input.definitions.size() * copies );
+    repeated.parameters.reserve( input.parameters.size() * copies );
+    for ( size_t c = 0; c < copies; c++ ) {
+        const std::string suffix = c == 0 ? std::string() : "~" + std::to_string( c );
+        for ( size_t d = 0; d < input.definitions.size(); d++ ) {
+            Definition definition = input.definitions[d];
+            definition.name += suffix;
+            if ( !definition.variable.empty() ) {
+                definition.variable += suffix;
+            }
+            repeated.definitions.push_back( definition );
+        }
+        for ( size_t p = 0; p < input.parameters.size(); p++ ) {
+            const std::string& parameter = input.parameters[p];
+            if ( parameter.length() > 2 && parameter[0] == '-' && parameter[1] == '-' ) {
+                repeated.parameters.push_back( parameter + suffix );
+            } else {
+                repeated.parameters.push_back( parameter );
+            }
+        }
+    }
+    return repeated;
+}
+
+
+void define( cmdlinecpp::Parser& parser, const Definition& definition ) {
+    switch ( definition.kind ) {
+        case 'a':
+            parser << cmdlinecpp::Action( definition.name, "A fuzzed action." );
+            break;
+        case 'p':
+            parser << cmdlinecpp::Option( definition.name, "A fuzzed positional argument.", definition.type );
+            break;
+        case 'e':
+            parser << cmdlinecpp::Option( definition.name, definition.short_name, "A fuzzed option.", definition.type ).from_environment( definition.variable );
+            break;
+        default:
+            parser << cmdlinecpp::Option( definition.name, definition.short_name, "A fuzzed option.", definition.type );
+            break;
+    }
+}
+
+
+/**
+ * @brief Read the value of an option with the type it was defined with
+ */
+void read_value( cmdlinecpp::Parser& parser, const std::string& name, cmdlinecpp::Data::Type type ) {
+    switch ( type ) {
+        case cmdlinecpp::Data::Type::Bool: {
+            bool value;
+            parser.to_variable( name, value );
+            break;
+        }
+        case cmdlinecpp::Data::Type::Double: {
+            double value;
+            parser.to_variable( name, value );
+            break;
+        }
+        case cmdlinecpp::Data::Type::Long: {
+            long value;
+            parser.to_variable( name, value );
+            break;
+        }
+        case cmdlinecpp::Data::Type::Int: {
+            int value;
+            parser.to_variable( name, value );
+            break;
+        }
+        case cmdlinecpp::Data::Type::Short: {
+            short value;
+            parser.to_variable( name, value );
+            break;
+        }
+        case cmdlinecpp::Data::Type::UnsignedLong: {
+            unsigned long value;
+            parser.to_variable( name, value );
+            break;
+        }
+        case cmdlinecpp::Data::Type::UnsignedInt: {
+            unsigned int value;
+            parser.to_variable( name, value );
+            break;
+        }
+        case cmdlinecpp::Data::Type::UnsignedShort: {
+            unsigned short value;
+            parser.to_variable( name, value );
+            break;
+        }
+        default: {
+            cmdlinecpp::StringView value;
+            parser.to_variable( name, value );
+            break;
+        }
+    }
+}
+
+
+/**
+ * @brief Define the schema, parse the command line and read everything back
+ * @returns The number of operations
+ * @note A NotFound escapes, because every name that was defined has to be found.
+ */
+uint64_t run( const FuzzInput& input ) {
+    const uint64_t start = operations();
+
+    cmdlinecpp::Parser parser;
+    for ( size_t d = 0; d < input.definitions.size(); d++ ) {
+        try {
+            define( parser, input.definitions[d] );
+        } catch ( std::logic_error& ) {
+            // A short specifier that is empty or too long
+        }
+    }
+
+    // A Parser does not answer completion requests or read response files, so they are parsed like any other parameter
+    std::vector< std::string > storage( 1, "fuzz" );
+    storage.insert( storage.end(), input.parameters.begin(), input.parameters.end() );
+    std::vector< char* > argv;
+    for ( size_t a = 0; a < storage.size(); a++ ) {
+        argv.push_back( &storage[a][0] );
+    }
+
+    bool parsed = false;
+    try {
+        parsed = parser.parse( static_cast< int >( argv.size() ), argv.data() );
+    } catch ( std::out_of_range& ) {
+    } catch ( cmdlinecpp::exceptions::TypeError& ) {
+    }
+
+    const cmdlinecpp::CmdLineArguments& arguments = parser.arguments();
+    if ( parsed ) {
+        for ( size_t d = 0; d < input.definitions.size(); d++ ) {
+            const Definition& definition = input.definitions[d];
+            if ( definition.kind == 'a' || !arguments.has_name( definition.name ) ) {
+                continue;
+            }
+            const uint32_t id = parser.option_id( definition.name );
+            parser.value( id );
+            parser.is_specified( definition.name );
+            parser.occurrences( definition.name );
+            read_value( parser, definition.name, arguments.option_by_id( id ).dataType() );
+        }
+        if ( parser.actions_enabled() ) {
+            parser.get_selected_action();
+        }
+
+        // Not the positional stream, as a single "-" would read stdin
+        const cmdlinecpp::ArgvSlice& last = parser.last_positionals();
+        for ( size_t p = 0; p < last.size(); p++ ) {
+            try {
+                cmdlinecpp::Value::from_text( arguments.options_positional().back().dataType(), last[p] );
+            } catch ( cmdlinecpp::exceptions::TypeError& ) {
+            }
+        }
+    }
+
+    parser.help();
+
+    std::vector< cmdlinecpp::StringView > words;
+    for ( size_t a = 0; a < storage.size(); a++ ) {
+        words.push_back( cmdlinecpp::StringView( storage[a] ) );
+    }
+    std::string completions;
+    cmdlinecpp::Completion::complete( arguments, words.data(), words.size(), words.size(), completions );
+    cmdlinecpp::Completion::complete( arguments, words.data(), words.size(), words.size() - 1, completions );
+
+    return operations() - start;
+}
+
+
+/**
+ * @brief The largest growth of the operations seen so far, as a multiple of the growth of the input
+ */
+double largest_growth = 0;
+
+
+void check( const uint8_t* data, size_t size ) {
+    const FuzzInput input = decode( data, size );
+    const uint64_t single = run( input );
+    const uint64_t repeated = run( repeat( input, scale ) );
+
+    const double growth = static_cast< double >( repeated ) / ( scale * ( single + base_operations ) );
+    largest_growth = std::max( largest_growth, growth );
+    if ( repeated > growth_slack * scale * ( single + base_operations ) ) {
+        std::cerr << "Superlinear: " << single << " operations for the input, but " << repeated
+                  << " for " << scale << " copies of it." << std::endl;
+        std::abort();
+    }
+}
+
+} // namespace
+
+
+#ifndef FUZZ_SANITIZER_ALLOCATOR
+
+void* operator new( std::size_t size ) {
+    ++allocations;
+    void* memory = std::malloc( size > 0 ? size : 1 );
+    if ( memory == nullptr ) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+
+void* operator new[]( std::size_t size ) {
+    return operator new( size );
+}
+
+
+void operator delete( void* memory ) noexcept {
+    std::free( memory );
+}
+
+
+void operator delete[]( void* memory ) noexcept {
+    std::free( memory );
+}
+
+#endif
+
+
+extern "C" int LLVMFuzzerTestOneInput( const uint8_t* data, size_t size ) {
+    check( data, size );
+    return 0;
+}
+
+
+#ifndef CMDLINECPP_LIBFUZZER
+
+namespace {
+
+/**
+ * @brief Parts of names and parameters, that are likely to clash or to reach the edge cases
+ */
+const char* const pieces[] = {
+    "a", "b", "ab", "h", "help", "v", "verbose", "out", "output", "x~1",
+    "-", "--", "=", "@", "0", "-1", "1e999", "nan", "0x10", "18446744073709551616",
+    "True", "False", "\xff", " ", "--cmdlinecpp-complete"
+};
+const size_t piece_count = sizeof( pieces ) / sizeof( pieces[0] );
+
+
+std::string piece( std::mt19937& random ) {
+    std::string result = pieces[ random() % piece_count ];
+    while ( random() % 3 == 0 ) {
+        result += pieces[ random() % piece_count ];
+    }
+    return result;
+}
+
+
+/**
+ * @brief Generate a schema and a command line, that mostly uses the defined names
+ */
+std::string generate( std::mt19937& random ) {
+    std::string text;
+    std::vector< std::string > names;
+    std::vector< std::string > shorts;
+    const size_t definitions = random() % 48;
+    for ( size_t d = 0; d < definitions; d++ ) {
+        const std::string name = piece( random ) + std::to_string( random() % 8 );
+        const std::string type = std::to_string( random() % 10 );
+        switch ( random() % 6 ) {
+            case 0:
+                text += "a " + name + "\n";
+                break;
+            case 1:
+                text += "p " + name + " " + type + "\n";
+                break;
+            case 2:
+                text += "e " + name + " " + name.substr( 0, 1 + random() % 3 ) + " " + type + " HOME\n";
+                break;
+            default:
+                shorts.push_back( name.substr( 0, 1 + random() % 4 ) );
+                text += "o " + name + " " + shorts.back() + " " + type + "\n";
+                break;
+        }
+        names.push_back( name );
+    }
+
+    text += "\n";
+    const size_t parameters = random() % 64;
+    for ( size_t p = 0; p < parameters; p++ ) {
+        const unsigned int choice = random() % 4;
+        if ( choice == 0 && !names.empty() ) {
+            text += "--" + names[ random() % names.size() ];
+        } else if ( choice == 1 && !shorts.empty() ) {
+            text += "-" + shorts[ random() % shorts.size() ];
+        } else if ( choice == 2 && !names.empty() ) {
+            text += names[ random() % names.size() ];
+        } else {
+            text += piece( random );
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+
+/**
+ * @brief Change an input a little: remove, repeat or swap lines, or replace a byte
+ */
+std::string mutate( const std::string& original, std::mt19937& random ) {
+    std::vector< std::string > lines = split( original, '\n' );
+    const unsigned int changes = 1 + random() % 4;
+    for ( unsigned int c = 0; c < changes; c++ ) {
+        const size_t line = random() % lines.size();
+        switch ( random() % 5 ) {
+            case 0:
+                if ( lines.size() > 1 ) {
+                    lines.erase( lines.begin() + line );
+                }
+                break;
+            case 1:
+                lines.insert( lines.begin() + line, lines[line] );
+                break;
+            case 2:
+                std::swap( lines[line], lines[ random() % lines.size() ] );
+                break;
+            case 3:
+                lines.insert( lines.begin() + line, piece( random ) );
+                break;
+            default:
+                if ( !lines[line].empty() ) {
+                    lines[line][ random() % lines[line].length() ] = piece( random )[0];
+                }
+                break;
+        }
+    }
+
+    std::string text;
+    for ( size_t l = 0; l < lines.size(); l++ ) {
+        text += ( l == 0 ? "" : "\n" ) + lines[l];
+    }
+    return text;
+}
+
+
+bool read_file( const std::string& path, std::string& contents ) {
+    std::ifstream file( path.c_str(), std::ios::in | std::ios::binary );
+    if ( !file ) {
+        return false;
+    }
+    contents.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+    return true;
+}
+
+
+/**
+ * @brief Collect the files of a path, which may be a file or a directory
+ */
+void collect_files( const std::string& path, std::vector< std::string >& files ) {
+#ifdef __unix__
+    DIR* directory = opendir( path.c_str() );
+    if ( directory != nullptr ) {
+        std::vector< std::string > entries;
+        while ( dirent* entry = readdir( directory ) ) {
+            const std::string file = path + "/" + entry->d_name;
+            struct stat status;
+            if ( stat( file.c_str(), &status ) == 0 && S_ISREG( status.st_mode ) ) {
+                entries.push_back( file );
+            }
+        }
+        closedir( directory );
+        std::sort( entries.begin(), entries.end() );
+        files.insert( files.end(), entries.begin(), entries.end() );
+        return;
+    }
+#endif
+    files.push_back( path );
+}
+
+
+#ifdef __unix__
+
+/**
+ * @brief The generated input that runs at the moment and the file it is saved to, if it crashes
+ */
+std::string current_input;
+char crash_path[64];
+
+
+void save_crashing_input( int signal_number ) {
+    const int fd = ::open( crash_path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if ( fd >= 0 ) {
+        if ( write( fd, current_input.data(), current_input.size() ) < 0 ) {
+            // Nothing left to do in a signal handler
+        }
+        close( fd );
+    }
+    signal( signal_number, SIG_DFL );
+    raise( signal_number );
+}
+
+#endif
+
+} // namespace
+
+
+int main( int argc, char** argv ) {
+    unsigned long runs = 0;
+    unsigned long seed = 1;
+    std::vector< std::string > files;
+    for ( int a = 1; a < argc; a++ ) {
+        const std::string argument = argv[a];
+        if ( argument.compare( 0, 6, "-runs=" ) == 0 ) {
+            runs = std::strtoul( argument.c_str() + 6, nullptr, 10 );
+        } else if ( argument.compare( 0, 6, "-seed=" ) == 0 ) {
+            seed = std::strtoul( argument.c_str() + 6, nullptr, 10 );
+        } else {
+            collect_files( argument, files );
+        }
+    }
+
+    if ( files.empty() && runs == 0 ) {
+        const std::string input( ( std::istreambuf_iterator< char >( std::cin ) ), std::istreambuf_iterator< char >() );
+        check( reinterpret_cast< const uint8_t* >( input.data() ), input.size() );
+        return 0;
+    }
+
+    std::vector< std::string > corpus;
+    for ( size_t f = 0; f < files.size(); f++ ) {
+        std::string contents;
+        if ( !read_file( files[f], contents ) ) {
+            std::cerr << "Could not read '" << files[f] << "'." << std::endl;
+            return 1;
+        }
+        std::cerr << "Running: " << files[f] << std::endl;
+        check( reinterpret_cast< const uint8_t* >( contents.data() ), contents.size() );
+        corpus.push_back( contents );
+    }
+
+#ifdef __unix__
+    signal( SIGSEGV, save_crashing_input );
+    signal( SIGABRT, save_crashing_input );
+    signal( SIGFPE, save_crashing_input );
+    signal( SIGBUS, save_crashing_input );
+#endif
+
+    std::mt19937 random( static_cast< std::mt19937::result_type >( seed ) );
+    for ( unsigned long r = 0; r < runs; r++ ) {
+        const std::string input = ( !corpus.empty() && random() % 2 == 0 )
+                                ? mutate( corpus[ random() % corpus.size() ], random )
+                                : generate( random );
+#ifdef __unix__
+        current_input = input;
+        std::snprintf( crash_path, sizeof( crash_path ), "crash-%lu-%lu", seed, r );
+#endif
+        check( reinterpret_cast< const uint8_t* >( input.data() ), input.size() );
+    }
+
+    std::cerr << "Executed " << files.size() + runs << " inputs, the operations grew at most "
+              << largest_growth << " times as fast as the inputs." << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * @file helplayout.cpp
+ * @brief A file that defines the layout of the help text for the width of the terminal
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#ifdef __unix__
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#include "helplayout.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief A range of code points with the same display width
+ */
+struct CodePointRange {
+    uint32_t first;
+    uint32_t last;
+};
+
+/**
+ * @brief Combining marks and other code points that take no cell, sorted
+ */
+const CodePointRange zero_width[] = {
+    { 0x0300, 0x036F }, { 0x0483, 0x0489 }, { 0x0591, 0x05BD }, { 0x0610, 0x061A },
+    { 0x064B, 0x065F }, { 0x0E31, 0x0E31 }, { 0x0E34, 0x0E3A }, { 0x0E47, 0x0E4E },
+    { 0x1AB0, 0x1AFF }, { 0x1DC0, 0x1DFF }, { 0x200B, 0x200F }, { 0x202A, 0x202E },
+    { 0x2060, 0x2064 }, { 0x20D0, 0x20FF }, { 0xFE00, 0xFE0F }, { 0xFE20, 0xFE2F },
+    { 0xFEFF, 0xFEFF }, { 0xE0100, 0xE01EF }
+};
+
+/**
+ * @brief East Asian wide and fullwidth code points that take two cells, sorted
+ */
+const CodePointRange double_width[] = {
+    { 0x1100, 0x115F }, { 0x2E80, 0x303E }, { 0x3041, 0x33FF }, { 0x3400, 0x4DBF },
+    { 0x4E00, 0x9FFF }, { 0xA000, 0xA4CF }, { 0xAC00, 0xD7A3 }, { 0xF900, 0xFAFF },
+    { 0xFE30, 0xFE4F }, { 0xFF00, 0xFF60 }, { 0xFFE0, 0xFFE6 }, { 0x1F300, 0x1F64F },
+    { 0x1F900, 0x1F9FF }, { 0x20000, 0x2FFFD }, { 0x30000, 0x3FFFD }
+};
+
+
+template< size_t N >
+bool is_in( const CodePointRange ( &ranges )[N], uint32_t code_point ) {
+    if ( code_point < ranges[0].first || code_point > ranges[N-1].last ) {
+        return false;
+    }
+    size_t low = 0;
+    size_t high = N;
+    while ( low < high ) {
+        const size_t middle = ( low + high ) / 2;
+        if ( code_point > ranges[middle].last ) {
+            low = middle + 1;
+        } else if ( code_point < ranges[middle].first ) {
+            high = middle;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * @brief Decode one UTF-8 sequence
+ * @param p The first byte
+ * @param end Behind the last byte of the text
+ * @param code_point Is set to the code point or U+FFFD, if the sequence is invalid
+ * @returns The number of bytes of the sequence, at least 1
+ */
+size_t decode( const unsigned char* p, const unsigned char* end, uint32_t& code_point ) {
+    const unsigned char lead = *p;
+    size_t length = 0;
+    if ( lead < 0x80 ) {
+        code_point = lead;
+        return 1;
+    } else if ( ( lead & 0xE0 ) == 0xC0 ) {
+        code_point = lead & 0x1F;
+        length = 2;
+    } else if ( ( lead & 0xF0 ) == 0xE0 ) {
+        code_point = lead & 0x0F;
+        length = 3;
+    } else if ( ( lead & 0xF8 ) == 0xF0 ) {
+        code_point = lead & 0x07;
+        length = 4;
+    } else {
+        code_point = 0xFFFD;
+        return 1;
+    }
+
+    if ( static_cast< size_t >( end - p ) < length ) {
+        code_point = 0xFFFD;
+        return 1;
+    }
+    for ( size_t c = 1; c < length; c++ ) {
+        if ( ( p[c] & 0xC0 ) != 0x80 ) {
+            code_point = 0xFFFD;
+            return 1;
+        }
+        code_point = ( code_point << 6 ) | ( p[c] & 0x3F );
+    }
+    return length;
+}
+
+
+size_t cell_width( uint32_t code_point ) {
+    if ( code_point < 0x20 || ( code_point >= 0x7F && code_point < 0xA0 ) ) {
+        return 0;
+    }
+    if ( code_point < 0x0300 ) {
+        return 1;
+    }
+    if ( is_in( zero_width, code_point ) ) {
+        return 0;
+    }
+    return is_in( double_width, code_point ) ? 2 : 1;
+}
+
+
+void append_spaces( std::string& out, size_t count ) {
+    out.append( count, ' ' );
+}
+
+
+bool is_space( char c ) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+} // namespace
+
+
+const size_t HelpLayout::indent;
+const size_t HelpLayout::min_text_width;
+
+
+HelpLayout::HelpLayout( size_t width, size_t longest_name )
+    :   m_width( width )
+    ,   m_column( std::min( indent + longest_name + 2, std::max( width / 2, indent + 8 ) ) )
+{}
+
+
+size_t HelpLayout::column() const {
+    return m_column;
+}
+
+
+void HelpLayout::append_entry( std::string& out, const StringView& name, const StringView& help_text ) const {
+    append_spaces( out, indent );
+    out.append( name.data(), name.length() );
+    const size_t position = indent + display_width( name );
+
+    if ( !help_text.empty() ) {
+        if ( position + 2 > m_column ) {
+            // The name is too long for the left column
+            out += '\n';
+            append_spaces( out, m_column );
+        } else {
+            append_spaces( out, m_column - position );
+        }
+        this->append_wrapped( out, help_text, m_column, m_column );
+    }
+    out += '\n';
+}
+
+
+void HelpLayout::append_wrapped( std::string& out, const StringView& text, size_t first, size_t column ) const {
+    const size_t available = std::max( m_width > column ? m_width - column : 0, min_text_width );
+    const size_t limit = column + available;
+
+    size_t position = first;
+    bool at_line_start = true;
+    size_t p = 0;
+    while ( p < text.length() ) {
+        if ( text[p] == '\n' ) {
+            out += '\n';
+            append_spaces( out, column );
+            position = column;
+            at_line_start = true;
+            ++p;
+            continue;
+        }
+        if ( is_space( text[p] ) ) {
+            ++p;
+            continue;
+        }
+
+        size_t word_end = p;
+        while ( word_end < text.length() && !is_space( text[word_end] ) && text[word_end] != '\n' ) {
+            ++word_end;
+        }
+        const StringView word = text.substr( p, word_end - p );
+        const size_t width = display_width( word );
+
+        if ( !at_line_start ) {
+            if ( position + 1 + width > limit ) {
+                out += '\n';
+                append_spaces( out, column );
+                position = column;
+            } else {
+                out += ' ';
+                ++position;
+            }
+        }
+
+        if ( position + width <= limit ) {
+            out.append( word.data(), word.length() );
+            position += width;
+        } else {
+            // A word longer than a line is broken at the last character that fits
+            const unsigned char* c = reinterpret_cast< const unsigned char* >( word.data() );
+            const unsigned char* end = c + word.length();
+            while ( c != end ) {
+                uint32_t code_point = 0;
+                const size_t length = decode( c, end, code_point );
+                const size_t cells = cell_width( code_point );
+                if ( position + cells > limit && position > column ) {
+                    out += '\n';
+                    append_spaces( out, column );
+                    position = column;
+                }
+                out.append( reinterpret_cast< const char* >( c ), length );
+                position += cells;
+                c += length;
+            }
+        }
+        at_line_start = false;
+        p = word_end;
+    }
+}
+
+
+size_t HelpLayout::terminal_width() {
+    static const size_t width = []() -> size_t {
+#ifdef __unix__
+        struct winsize size;
+        if ( ioctl( STDOUT_FILENO, TIOCGWINSZ, &size ) == 0 && size.ws_col > 0 ) {
+            return size.ws_col;
+        }
+#endif
+        // Pagers and pipes have no size, but the shell may export the width
+        const char* columns = std::getenv( "COLUMNS" );
+        if ( columns != nullptr ) {
+            const long value = std::strtol( columns, nullptr, 10 );
+            if ( value > 0 ) {
+                return static_cast< size_t >( value );
+            }
+        }
+        return 80;
+    }();
+
+    return width;
+}
+
+
+size_t HelpLayout::display_width( const StringView& text ) {
+    const unsigned char* p = reinterpret_cast< const unsigned char* >( text.data() );
+    const unsigned char* end = p + text.length();
+
+    size_t width = 0;
+    while ( p != end ) {
+        if ( *p < 0x80 ) {
+            // ASCII needs no decoding
+            width += ( *p >= 0x20 && *p != 0x7F ) ? 1 : 0;
+            ++p;
+            continue;
+        }
+        uint32_t code_point = 0;
+        p += decode( p, end, code_point );
+        width += cell_width( code_point );
+    }
+    return width;
+}
+
+
+} // namespace cmdlinecpp
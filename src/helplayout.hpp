@@ -0,0 +1,107 @@
+/**
+ * @file helplayout.hpp
+ * @brief A file that defines the layout of the help text for the width of the terminal
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "stringview.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief Lays out the help text in two columns, the names on the left and the wrapped help texts on the right
+ *
+ * All widths are display cells, not bytes: UTF-8 sequences are decoded, combining marks take no cell and
+ * East Asian wide characters take two cells.
+ */
+class HelpLayout {
+    /**
+     * @brief The width of the whole line
+     */
+    size_t m_width;
+    /**
+     * @brief The cell the help texts start at
+     */
+    size_t m_column;
+
+public:
+    /**
+     * @brief The number of cells in front of every name
+     */
+    static const size_t indent = 2;
+    /**
+     * @brief The fewest cells a help text gets per line, even on very narrow terminals
+     */
+    static const size_t min_text_width = 20;
+
+    /**
+     * @brief Constructor.
+     * @param width The width of a line in cells
+     * @param longest_name The width of the longest name in the left column
+     * @note The left column takes at most half of the line. Longer names get their help text on the next line.
+     */
+    HelpLayout( size_t width, size_t longest_name );
+
+    /**
+     * @brief Get the cell the help texts start at
+     * @returns The width of the left column
+     */
+    size_t column() const;
+
+    /**
+     * @brief Append one entry of a list, e.g. an option and its help text
+     * @param out The help to append to
+     * @param name The name in the left column
+     * @param help_text The text to wrap into the right column. Line breaks in it are kept.
+     */
+    void append_entry( std::string& out, const StringView& name, const StringView& help_text ) const;
+    /**
+     * @brief Append text wrapped at word boundaries
+     * @param out The help to append to
+     * @param text The text to wrap. Line breaks in it are kept.
+     * @param first The cell the first line starts at, because something is already written in front of it
+     * @param column The cell every following line is indented to
+     */
+    void append_wrapped( std::string& out, const StringView& text, size_t first, size_t column ) const;
+
+    /**
+     * @brief Get the width of the terminal
+     * @returns The columns of the terminal stdout is connected to, or of $COLUMNS, or 80. It is determined once per process.
+     */
+    static size_t terminal_width();
+    /**
+     * @brief Measure the display width of UTF-8 text
+     * @param text The text
+     * @returns The number of cells the text takes in a terminal
+     */
+    static size_t display_width( const StringView& text );
+};
+
+
+} // namespace cmdlinecpp
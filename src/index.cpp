@@ -0,0 +1,174 @@
+/**
+ * @file index.cpp
+ * @brief A file that defines an immutable hash index over option and action names
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "index.hpp"
+
+
+namespace cmdlinecpp {
+
+
+#ifdef CMDLINECPP_PARSE_STATS
+namespace {
+
+/**
+ * @brief The number of slots compared by the lookups of this thread
+ */
+thread_local uint64_t probe_count = 0;
+
+} // namespace
+#endif
+
+
+const uint32_t NameIndex::npos;
+
+
+NameIndex::NameIndex()
+    :   m_slots()
+    ,   m_size( 0 )
+{}
+
+
+void NameIndex::reset( size_t count ) {
+    // Keep the load factor at or below 0.5, so probe sequences stay short
+    size_t capacity = 4;
+    while ( capacity < count * 2 ) {
+        capacity <<= 1;
+    }
+
+    Slot empty = { 0, nullptr, 0, npos };
+    m_slots.assign( capacity, empty );
+    m_size = 0;
+}
+
+
+bool NameIndex::insert( const char* key, size_t length, uint32_t value ) {
+    const uint64_t h = hash( key, length );
+    const size_t mask = m_slots.size() - 1;
+
+    for ( size_t s = h & mask; ; s = (s + 1) & mask ) {
+        Slot& slot = m_slots[s];
+        if ( slot.key == nullptr ) {
+            slot.hash = h;
+            slot.key = key;
+            slot.length = static_cast< uint32_t >( length );
+            slot.value = value;
+            ++m_size;
+            return true;
+        }
+        if ( slot.hash == h
+          && slot.length == length
+          && std::memcmp( slot.key, key, length ) == 0
+        ) {
+            return false;
+        }
+    }
+}
+
+
+uint32_t NameIndex::find( const char* key, size_t length ) const {
+    return this->find( key, length, hash( key, length ) );
+}
+
+
+uint32_t NameIndex::find( const char* key, size_t length, uint64_t h ) const {
+    if ( m_size == 0 ) {
+        return npos;
+    }
+
+    const size_t mask = m_slots.size() - 1;
+    for ( size_t s = h & mask; ; s = (s + 1) & mask ) {
+        const Slot& slot = m_slots[s];
+#ifdef CMDLINECPP_PARSE_STATS
+        ++probe_count;
+#endif
+        if ( slot.key == nullptr ) {
+            return npos;
+        }
+        if ( slot.hash == h
+          && slot.length == length
+          && std::memcmp( slot.key, key, length ) == 0
+        ) {
+            return slot.value;
+        }
+    }
+}
+
+
+uint64_t NameIndex::probes() {
+#ifdef CMDLINECPP_PARSE_STATS
+    return probe_count;
+#else
+    return 0;
+#endif
+}
+
+
+size_t NameIndex::size() const {
+    return m_size;
+}
+
+
+const std::vector< NameIndex::Slot >& NameIndex::slots() const {
+    return m_slots;
+}
+
+
+void NameIndex::assign( std::vector< Slot > slots ) {
+    if ( slots.empty() || ( slots.size() & ( slots.size() - 1 ) ) != 0 ) {
+        throw std::invalid_argument("The number of slots has to be a power of two.");
+    }
+
+    size_t size = 0;
+    for ( size_t s = 0; s < slots.size(); s++ ) {
+        if ( slots[s].key != nullptr ) {
+            ++size;
+        }
+    }
+    if ( size == slots.size() ) {
+        // find stops at the first empty slot
+        throw std::invalid_argument("At least one slot has to be empty.");
+    }
+
+    m_slots.swap( slots );
+    m_size = size;
+}
+
+
+uint64_t NameIndex::hash( const char* key, size_t length ) {
+    uint64_t h = 14695981039346656037ULL;
+    for ( size_t c = 0; c < length; c++ ) {
+        h ^= static_cast< unsigned char >( key[c] );
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,136 @@
+/**
+ * @file index.hpp
+ * @brief A file that defines an immutable hash index over option and action names
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief An open-addressing hash table that maps names to numeric ids.
+ * @note The keys are not copied. They have to stay valid as long as the index is used.
+ */
+class NameIndex {
+public:
+    /**
+     * @brief One slot of the hash table. A slot with a nullptr as key is empty.
+     */
+    struct Slot {
+        uint64_t hash;
+        const char* key;
+        uint32_t length;
+        uint32_t value;
+    };
+
+protected:
+    /**
+     * @brief The slots of the table. The size is always a power of two.
+     */
+    std::vector< Slot > m_slots;
+    /**
+     * @brief The number of keys inserted
+     */
+    size_t m_size;
+
+public:
+    /**
+     * @brief The value returned by find, if a key is not in the index
+     */
+    static const uint32_t npos = 0xffffffff;
+
+    /**
+     * @brief Default constructor. Constructs an empty index.
+     */
+    NameIndex();
+
+    /**
+     * @brief Drop all keys and prepare the table for the given number of keys
+     * @param count The number of keys that will be inserted
+     */
+    void reset( size_t count );
+    /**
+     * @brief Insert a key, if it is not already in this index
+     * @param key Pointer to the first character of the key
+     * @param length The length of the key in bytes
+     * @param value The id to store for the key
+     * @returns False, if the key was already in this index. The first inserted value is kept then.
+     * @warning The index must have been reset with a count that is big enough before
+     */
+    bool insert( const char* key, size_t length, uint32_t value );
+
+    /**
+     * @brief Look up a key
+     * @param key Pointer to the first character of the key
+     * @param length The length of the key in bytes
+     * @returns The value stored for key or NameIndex::npos, if the key is not in this index
+     */
+    uint32_t find( const char* key, size_t length ) const;
+    /**
+     * @brief Look up a key with an already computed hash
+     * @param key Pointer to the first character of the key
+     * @param length The length of the key in bytes
+     * @param hash The result of NameIndex::hash for key
+     * @returns The value stored for key or NameIndex::npos, if the key is not in this index
+     */
+    uint32_t find( const char* key, size_t length, uint64_t hash ) const;
+    /**
+     * @brief Get the number of slots compared by all lookups of the calling thread
+     * @returns The number of slots, always 0 without CMDLINECPP_PARSE_STATS
+     */
+    static uint64_t probes();
+
+    /**
+     * @brief Get the number of keys in this index
+     * @returns The number of keys in this index
+     */
+    size_t size() const;
+    /**
+     * @brief Get the slots of the table, e.g. to store the table in a file
+     * @returns The slots. The number of slots is a power of two.
+     */
+    const std::vector< Slot >& slots() const;
+    /**
+     * @brief Replace the table by slots that were built before, without hashing or probing again
+     * @param slots The slots as returned by slots(), but with keys that are valid as long as this index is used
+     * @throws std::invalid_argument If the number of slots is no power of two or no slot is empty
+     */
+    void assign( std::vector< Slot > slots );
+
+    /**
+     * @brief The hash function used by this index (64 bit FNV-1a)
+     * @param key Pointer to the first character of the key
+     * @param length The length of the key in bytes
+     * @returns The hash of the key
+     */
+    static uint64_t hash( const char* key, size_t length );
+};
+
+
+} // namespace cmdlinecpp
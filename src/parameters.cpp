@@ -23,124 +23,413 @@
     USA
 */
 
+#include <algorithm>
 #include <iostream>
 
+#include "convert.hpp"
 #include "parameters.hpp"
 
 
 namespace cmdlinecpp {
 
 
-CmdLineParameters::CmdLineParameters()
-    :   m_parameters()
-    ,   m_last_positionals_list()
+namespace {
+
+/**
+ * @brief Get the slot of an option that was not given
+ * @param data_type The data type of the option. A Bool option is False.
+ */
+Value unset_value( Data::Type data_type ) {
+    Value value( data_type );
+    if ( data_type == Data::Type::Bool ) {
+        value.text = StringView( FALSE );
+        value.as_bool = false;
+    }
+    return value;
+}
+
+} // namespace
+
+
+Value::Value( Data::Type data_type )
+    :   type( data_type )
+    ,   is_set( false )
+    ,   text()
+    ,   as_unsigned_long( 0 )
+{}
+
+
+Value Value::from_text( Data::Type data_type, const StringView& text ) {
+    Value value( data_type );
+    value.text = text;
+    value.is_set = true;
+    
+    switch ( data_type ) {
+        case Data::Type::Bool:
+            value.as_bool = ( text == TRUE );
+            break;
+        case Data::Type::Double:
+            value.as_double = convert::to_double( text );
+            break;
+        case Data::Type::Long:
+            value.as_long = convert::to_long( text );
+            break;
+        case Data::Type::Int:
+            value.as_int = convert::to_int( text );
+            break;
+        case Data::Type::Short:
+            value.as_short = convert::to_short( text );
+            break;
+        case Data::Type::UnsignedLong:
+            value.as_unsigned_long = convert::to_unsigned_long( text );
+            break;
+        case Data::Type::UnsignedInt:
+            value.as_unsigned_int = convert::to_unsigned_int( text );
+            break;
+        case Data::Type::UnsignedShort:
+            value.as_unsigned_short = convert::to_unsigned_short( text );
+            break;
+        default:
+            break;
+    }
+    
+    return value;
+}
+
+
+Occurrences::Occurrences( const Value* begin, const Value* end )
+    :   m_begin( begin )
+    ,   m_end( end )
+{}
+
+
+const Value* Occurrences::begin() const {
+    return m_begin;
+}
+
+
+const Value* Occurrences::end() const {
+    return m_end;
+}
+
+
+size_t Occurrences::size() const {
+    return m_end - m_begin;
+}
+
+
+const Value& Occurrences::operator[]( size_t index ) const {
+    return m_begin[index];
+}
+
+
+ArgvSlice::ArgvSlice()
+    :   m_begin( nullptr )
+    ,   m_end( nullptr )
+{}
+
+
+ArgvSlice::ArgvSlice( const StringView* begin, const StringView* end )
+    :   m_begin( begin )
+    ,   m_end( end )
+{}
+
+
+const StringView* ArgvSlice::begin() const {
+    return m_begin;
+}
+
+
+const StringView* ArgvSlice::end() const {
+    return m_end;
+}
+
+
+size_t ArgvSlice::size() const {
+    return m_end - m_begin;
+}
+
+
+bool ArgvSlice::empty() const {
+    return m_begin == m_end;
+}
+
+
+const StringView& ArgvSlice::operator[]( size_t index ) const {
+    return m_begin[index];
+}
+
+
+CmdLineParameters::CmdLineParameters( MemoryResource* resource )
+    :   m_arguments( nullptr )
+    ,   m_values( resource )
+    ,   m_occurrences( resource )
+    ,   m_occurrence_begin( resource )
+    ,   m_occurrence_end( resource )
+    ,   m_touched( resource )
+    ,   m_pending_ids( resource )
+    ,   m_pending_values( resource )
+    ,   m_fill( resource )
+    ,   m_last_positionals()
+    ,   m_positional_storage( resource )
     ,   m_action()
 {}
 
 
-CmdLineParameters::CmdLineParameters( const CmdLineArguments* cl_args )
-    :   m_parameters()
+CmdLineParameters::CmdLineParameters( const CmdLineArguments* cl_args, MemoryResource* resource )
+    :   m_arguments( cl_args )
+    ,   m_values( resource )
+    ,   m_occurrences( resource )
+    ,   m_occurrence_begin( cl_args->option_count(), 0, resource )
+    ,   m_occurrence_end( cl_args->option_count(), 0, resource )
+    ,   m_touched( resource )
+    ,   m_pending_ids( resource )
+    ,   m_pending_values( resource )
+    ,   m_fill( cl_args->option_count(), 0, resource )
+    ,   m_last_positionals()
+    ,   m_positional_storage( resource )
+    ,   m_action()
 {
-    for ( unsigned int o = 0
-        ; o < cl_args->options_regular().size()
-        ; o++
-    ) {
-        Option option = cl_args->options_regular().at( o );
-        this->add_option_key( option.option() );
-        
-        if ( option.dataType() == Data::Type::Bool ) {
-            this->set( option.option(), FALSE );
-        }
+    m_values.reserve( cl_args->option_count() );
+    for ( uint32_t id = 0; id < cl_args->option_count(); id++ ) {
+        m_values.push_back( unset_value( cl_args->option_by_id( id ).dataType() ) );
+    }
+}
+
+
+void CmdLineParameters::reserve( size_t count ) {
+    m_pending_ids.reserve( count );
+    m_pending_values.reserve( count );
+    m_occurrences.reserve( m_occurrences.size() + count );
+}
+
+
+
+const Value* CmdLineParameters::find( const std::string& option_name ) const {
+    if ( m_arguments == nullptr ) {
+        return nullptr;
     }
     
-    for ( unsigned int o = 0
-        ; o < cl_args->options_positional().size()
-        ; o++
-    ) {
-        Option option = cl_args->options_positional().at( o );
-        this->add_option_key( option.option() );
+    const uint32_t id = m_arguments->option_id( option_name );
+    if ( id >= m_values.size() ) {
+        return nullptr;
     }
+    
+    return &m_values[id];
 }
 
 
-
 void CmdLineParameters::add_option_key( const std::string option_name ) {
-    std::string empty;
-    m_parameters.insert( std::make_pair(option_name, empty) );
+    if ( this->find( option_name ) == nullptr ) {
+        std::cerr << "Argument '" << option_name << "' not found in parameter list." << std::endl;
+    }
 }
 
 
-void CmdLineParameters::set( const std::string option_name, const std::string parameter ) {
-    try {
-        m_parameters.at( option_name ) = parameter;
-    } catch ( std::out_of_range& oor ) {
+void CmdLineParameters::set( const std::string& option_name, const StringView& parameter ) {
+    const Value* value = this->find( option_name );
+    if ( value == nullptr ) {
         std::cerr << "Argument '" << option_name << "' not found in parameter list." << std::endl;
+        return;
+    }
+    
+    this->set( static_cast< uint32_t >( value - m_values.data() ), parameter );
+}
+
+
+void CmdLineParameters::set( uint32_t id, const StringView& parameter ) {
+    const Value value = Value::from_text( m_values.at( id ).type, parameter );
+    
+    m_values[id] = value;
+    m_pending_ids.push_back( id );
+    m_pending_values.push_back( value );
+}
+
+
+void CmdLineParameters::finish() {
+    if ( m_pending_ids.empty() ) {
+        return;
+    }
+    
+    // Only the options with values take part: the ones new to m_touched are sorted in, then the values
+    // of every touched option move back by the number of pending values of the touched options before
+    // it, and the pending values are sorted in behind them in their order.
+    const size_t touched = m_touched.size();
+    for ( size_t p = 0; p < m_pending_ids.size(); p++ ) {
+        const uint32_t id = m_pending_ids[p];
+        if ( m_fill[id]++ == 0 && m_occurrence_begin[id] == m_occurrence_end[id] ) {
+            m_touched.push_back( id );
+        }
+    }
+    // Rotated in one by one, as std::inplace_merge may allocate a buffer
+    std::sort( m_touched.begin() + touched, m_touched.end() );
+    for ( size_t t = touched; t < m_touched.size() && touched > 0; t++ ) {
+        std::rotate( std::upper_bound( m_touched.begin(), m_touched.begin() + t, m_touched[t] ), m_touched.begin() + t, m_touched.begin() + t + 1 );
+    }
+    
+    uint32_t shift = static_cast< uint32_t >( m_pending_ids.size() );
+    uint32_t old_end = static_cast< uint32_t >( m_occurrences.size() );
+    m_occurrences.resize( m_occurrences.size() + m_pending_ids.size() );
+    for ( size_t t = m_touched.size(); t-- > 0; ) {
+        const uint32_t id = m_touched[t];
+        const uint32_t pending = m_fill[id];
+        const uint32_t old_begin = old_end - ( m_occurrence_end[id] - m_occurrence_begin[id] );
+        shift -= pending;
+        
+        std::copy_backward( m_occurrences.begin() + old_begin, m_occurrences.begin() + old_end, m_occurrences.begin() + old_end + shift );
+        m_occurrence_begin[id] = old_begin + shift;
+        m_occurrence_end[id] = old_end + shift + pending;
+        if ( pending > 0 ) {
+            m_fill[id] = old_end + shift;
+        }
+        old_end = old_begin;
+    }
+    for ( size_t p = 0; p < m_pending_ids.size(); p++ ) {
+        m_occurrences[ m_fill[ m_pending_ids[p] ]++ ] = m_pending_values[p];
+    }
+    for ( size_t p = 0; p < m_pending_ids.size(); p++ ) {
+        m_fill[ m_pending_ids[p] ] = 0;
+    }
+    
+    m_pending_ids.clear();
+    m_pending_values.clear();
+}
+
+
+void CmdLineParameters::reset() {
+    for ( size_t t = 0; t < m_touched.size(); t++ ) {
+        const uint32_t id = m_touched[t];
+        m_values[id] = unset_value( m_values[id].type );
+        m_occurrence_begin[id] = 0;
+        m_occurrence_end[id] = 0;
     }
+    // Values set after the last finish have a slot, but no occurrences yet
+    for ( size_t p = 0; p < m_pending_ids.size(); p++ ) {
+        const uint32_t id = m_pending_ids[p];
+        m_values[id] = unset_value( m_values[id].type );
+    }
+    
+    m_touched.clear();
+    m_occurrences.clear();
+    m_pending_ids.clear();
+    m_pending_values.clear();
+    m_last_positionals = ArgvSlice();
+    m_positional_storage.clear();
+    m_action = StringView();
 }
 
 
-void CmdLineParameters::set_action( const std::string action ) {
+void CmdLineParameters::set_action( const StringView& action ) {
     m_action = action;
 }
 
 
 const std::string CmdLineParameters::get( const std::string option_name ) const {
-    try {
-         return m_parameters.at( option_name );
-    } catch ( std::exception& e ) {
+    return this->view( option_name ).str();
+}
+
+
+StringView CmdLineParameters::view( const std::string& option_name ) const {
+    const Value* value = this->find( option_name );
+    if ( value == nullptr ) {
         std::cerr << "Argument '" << option_name << "' not found in parameter list." << std::endl;
+        return StringView();
+    }
+    
+    return value->text;
+}
+
+
+const Value& CmdLineParameters::value( uint32_t id ) const {
+    return m_values.at( id );
+}
+
+
+const Value& CmdLineParameters::occurrence( uint32_t id, unsigned int appearence ) const {
+    if ( appearence == 0 ) {
+        return m_values.at( id );
+    }
+    
+    const Occurrences values = this->occurrences( id );
+    if ( appearence > values.size() ) {
+        throw std::out_of_range("The option was not given that many times.");
     }
     
-    return std::string("");
+    return values[ appearence - 1 ];
+}
+
+
+Occurrences CmdLineParameters::occurrences( uint32_t id ) const {
+    if ( id >= m_values.size() ) {
+        throw std::out_of_range("There is no option with this id.");
+    }
+    
+    const Value* buffer = m_occurrences.data();
+    return Occurrences( buffer + m_occurrence_begin[id], buffer + m_occurrence_end[id] );
 }
 
 
 const std::string CmdLineParameters::get_action() const {
-    return m_action;
+    return m_action.str();
+}
+
+
+void CmdLineParameters::set_last_positionals( const std::vector< StringView >& last_positionals_list ) {
+    // The vector belongs to the caller, so the views are kept in the arena
+    m_positional_storage.assign( last_positionals_list.begin(), last_positionals_list.end() );
+    m_last_positionals = ArgvSlice( m_positional_storage.data(), m_positional_storage.data() + m_positional_storage.size() );
 }
 
 
-void CmdLineParameters::set_last_positionals( std::vector< std::string > last_positionals_list ) {
-    m_last_positionals_list = last_positionals_list;
+void CmdLineParameters::set_last_positionals( const StringView* first, const StringView* last ) {
+    m_last_positionals = ArgvSlice( first, last );
 }
 
 
 std::vector< std::string > CmdLineParameters::get_last_positionals() const {
-    return m_last_positionals_list;
+    std::vector< std::string > last_positionals;
+    last_positionals.reserve( m_last_positionals.size() );
+    for ( size_t p = 0; p < m_last_positionals.size(); p++ ) {
+        last_positionals.push_back( m_last_positionals[p].str() );
+    }
+    return last_positionals;
+}
+
+
+const ArgvSlice& CmdLineParameters::last_positionals() const {
+    return m_last_positionals;
 }
 
 
 bool CmdLineParameters::has_value( const std::string option_name ) const {
-    try {
-        if ( m_parameters.at( option_name ).length() > 0 ) {
-            return true;
-        }
-    } catch ( std::out_of_range& oor ) {
-        return false;
-    }
-    return false;
+    const Value* value = this->find( option_name );
+    return value != nullptr && value->text.length() > 0;
 }
 
 
 bool CmdLineParameters::is_specified( const std::string option_name ) const {
-    try {
-        m_parameters.at( option_name );
-        return true;
-    } catch ( std::out_of_range& oor ) {
-        return false;
-    }
-    return false;
+    return this->find( option_name ) != nullptr;
 }
 
 
 
 const size_t CmdLineParameters::size() const {
-    return m_parameters.size();
+    return m_values.size();
 }
 
 
 void CmdLineParameters::clear() {
-    m_parameters.clear();
+    m_values.clear();
+    m_occurrences.clear();
+    m_occurrence_begin.clear();
+    m_occurrence_end.clear();
+    m_touched.clear();
+    m_pending_ids.clear();
+    m_pending_values.clear();
+    m_fill.clear();
+    m_last_positionals = ArgvSlice();
+    m_positional_storage.clear();
+    m_action = StringView();
 }
 
 
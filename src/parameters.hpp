@@ -25,62 +25,272 @@
 
 #pragma once
 
+#include "arena.hpp"
 #include "arguments.hpp"
+#include "stringview.hpp"
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 
 namespace cmdlinecpp {
 
 
+/**
+ * @brief A tagged slot that holds the value of one option, converted to its Data::Type once while parsing
+ */
+struct Value {
+    /**
+     * @brief The data type of the option. Selects the valid member of the union below.
+     */
+    Data::Type type;
+    /**
+     * @brief True, if a value was set for the option
+     */
+    bool is_set;
+    /**
+     * @brief A view on the value as it was passed
+     */
+    StringView text;
+    /**
+     * @brief The converted value
+     */
+    union {
+        bool as_bool;
+        double as_double;
+        long as_long;
+        int as_int;
+        short as_short;
+        unsigned long as_unsigned_long;
+        unsigned int as_unsigned_int;
+        unsigned short as_unsigned_short;
+    };
+    
+    /**
+     * @brief Constructor. Constructs an empty slot for a data type.
+     * @param data_type The data type of the option
+     */
+    explicit Value( Data::Type data_type = Data::Type::Void );
+    
+    /**
+     * @brief Convert a parameter to a data type
+     * @param data_type The data type to convert to
+     * @param text A view on the parameter. It is not copied.
+     * @returns A slot that is set to the converted parameter
+     * @throws TypeError If the parameter can not be converted to data_type
+     */
+    static Value from_text( Data::Type data_type, const StringView& text );
+};
+
+
+/**
+ * @brief A non-owning range over all values given for one option, in the order they were passed
+ */
+class Occurrences {
+    const Value* m_begin;
+    const Value* m_end;
+    
+public:
+    /**
+     * @brief Constructor.
+     * @param begin The first value
+     * @param end Behind the last value
+     */
+    Occurrences( const Value* begin, const Value* end );
+    
+    /**
+     * @brief Get an iterator to the first value
+     */
+    const Value* begin() const;
+    /**
+     * @brief Get an iterator behind the last value
+     */
+    const Value* end() const;
+    /**
+     * @brief Get the number of values
+     * @returns How often the option was given
+     */
+    size_t size() const;
+    /**
+     * @brief Access a value
+     * @param index The index of the value, starting with 0
+     * @returns The value
+     */
+    const Value& operator[]( size_t index ) const;
+};
+
+
+/**
+ * @brief A non-owning range over a part of the command line parameters, e.g. the last positional list
+ */
+class ArgvSlice {
+    const StringView* m_begin;
+    const StringView* m_end;
+    
+public:
+    /**
+     * @brief Constructor. Constructs an empty slice.
+     */
+    ArgvSlice();
+    /**
+     * @brief Constructor.
+     * @param begin The first parameter
+     * @param end Behind the last parameter
+     */
+    ArgvSlice( const StringView* begin, const StringView* end );
+    
+    /**
+     * @brief Get an iterator to the first parameter
+     */
+    const StringView* begin() const;
+    /**
+     * @brief Get an iterator behind the last parameter
+     */
+    const StringView* end() const;
+    /**
+     * @brief Get the number of parameters
+     * @returns The number of parameters
+     */
+    size_t size() const;
+    /**
+     * @brief Test, if the slice is empty
+     * @returns True, if there are no parameters
+     */
+    bool empty() const;
+    /**
+     * @brief Access a parameter
+     * @param index The index of the parameter, starting with 0
+     * @returns A view on the parameter
+     */
+    const StringView& operator[]( size_t index ) const;
+};
+
+
 /**
  * @brief A class that holds the parameters specified for options specified in a CmdLineOptions class
  */
 class CmdLineParameters {
+    friend class Snapshot;
+    
 protected:
     /**
-     * @brief The parameters that where parsed. The first is the option name that can be looked up and the second is the parameter specified for this option
+     * @brief The definitions the option ids refer to
+     */
+    const CmdLineArguments* m_arguments;
+    /**
+     * @brief The parameters that where parsed. The option id is the index and the slot holds the converted value for this option
+     */
+    ArenaVector< Value > m_values;
+    /**
+     * @brief All values of all options, sorted by option id and then by the order they were given
+     */
+    ArenaVector< Value > m_occurrences;
+    /**
+     * @brief The values of option id are m_occurrences[ m_occurrence_begin[id] ] to m_occurrences[ m_occurrence_end[id] - 1 ]
+     */
+    ArenaVector< uint32_t > m_occurrence_begin;
+    /**
+     * @brief Behind the last value of an option in m_occurrences. Equal to m_occurrence_begin, if the option has no values.
+     */
+    ArenaVector< uint32_t > m_occurrence_end;
+    /**
+     * @brief The ids of the options with values in m_occurrences in ascending order, so finish and reset touch only them
+     */
+    ArenaVector< uint32_t > m_touched;
+    /**
+     * @brief The option ids of the values set since the last call of finish
+     */
+    ArenaVector< uint32_t > m_pending_ids;
+    /**
+     * @brief The values set since the last call of finish
+     */
+    ArenaVector< Value > m_pending_values;
+    /**
+     * @brief Where finish sorts the next pending value of an option to. It is 0 for every option outside of finish.
+     */
+    ArenaVector< uint32_t > m_fill;
+    /**
+     * @brief The last positional parameters as slice of the parsed parameters
      */
-    std::map< std::string, std::string > m_parameters;
+    ArgvSlice m_last_positionals;
     /**
-     * @brief The last positional parameters as list
+     * @brief The views of the last positional parameters, if they do not point into an argv array, e.g. after loading a Snapshot
      */
-    std::vector< std::string > m_last_positionals_list;
+    ArenaVector< StringView > m_positional_storage;
     /**
-     * @brief The selected action
+     * @brief A view on the selected action
      */
-    std::string m_action;
+    StringView m_action;
+    
+    /**
+     * @brief Get the slot of an option by its name
+     * @param option_name The name of the option
+     * @returns A pointer to the slot or nullptr, if the option has no slot in this class
+     */
+    const Value* find( const std::string& option_name ) const;
     
 public:
     /**
      * @brief Constructor. Constructs a class with no parameters specified
+     * @param resource The memory resource all parse state is allocated from. It has to outlive this class.
      */
-    CmdLineParameters();
+    explicit CmdLineParameters( MemoryResource* resource = new_delete_resource() );
     /**
-     * @brief Constructor. Constructs a class with option keys specified by an existing CmdLineArguments environment
+     * @brief Constructor. Constructs a class with one slot for every option specified by an existing CmdLineArguments environment
+     * @param cl_args The definitions of the options. They have to outlive this class.
+     * @param resource The memory resource all parse state is allocated from. It has to outlive this class.
      */
-    CmdLineParameters( const CmdLineArguments* cl_args );
+    CmdLineParameters( const CmdLineArguments* cl_args
+                     , MemoryResource* resource = new_delete_resource() );
+    
+    /**
+     * @brief Reserve memory for a number of values, so setting them does not grow the buffers
+     * @param count The number of values that will be set at most, e.g. the number of command line parameters
+     */
+    void reserve( size_t count );
     
     /**
      * @brief Add a new key to this class. Its parameter element will be an empty string until specified.
      * @param option_name Name of the option
+     * @note Every option of the CmdLineArguments passed to the constructor already has a slot. This only checks, that option_name is one of them.
      */
     void add_option_key( const std::string option_name );
     
     /**
      * @brief Set the parameter element of a given key to a value
      * @param option_name The name of the option to set the parameter for
-     * @param parameter The value of the option
-     * @throws std::out_of_range If the option key was not found in this class
+     * @param parameter A view on the value of the option
+     * @warning The value is not copied. The viewed characters have to outlive this class, like the argv array of a main function does.
      */
-    void set( const std::string option_name
-            , const std::string parameter );
+    void set( const std::string& option_name
+            , const StringView& parameter );
+    /**
+     * @brief Set the parameter of an option by its id and convert it to the option's Data::Type
+     * @param id The id of the option as defined by CmdLineArguments::option_id
+     * @param parameter A view on the value of the option
+     * @throws TypeError If the parameter can not be converted to the option's Data::Type
+     * @warning The value is not copied. The viewed characters have to outlive this class, like the argv array of a main function does.
+     */
+    void set( uint32_t id
+            , const StringView& parameter );
+    /**
+     * @brief Sort all values set so far into the shared occurrence buffer, so occurrence and occurrences work in O(1)
+     * @note Parser::parse calls this once after all sources are read. Call it yourself after setting values manually
+     *       or after Parser::parse_parameters, parse_environment or parse_config.
+     */
+    void finish();
+    /**
+     * @brief Forget all values, the action and the last positional list, so the slots can be used for the next parse
+     * @note Only the options that were set are touched, so this costs nothing for the options that were not given.
+     */
+    void reset();
     /**
      * @brief Set the action that is selected
-     * @param action The action, that was selected
+     * @param action A view on the action, that was selected
+     * @warning The action is not copied. The viewed characters have to outlive this class.
      */
-    void set_action( const std::string action );
+    void set_action( const StringView& action );
     
     /**
      * @brief Get the value for an option
@@ -88,6 +298,33 @@ public:
      * @returns A string containing the value of the option key. Returns an empty string, if the option for option_name is not found in this class or no value is set for this key
      */
     const std::string get( const std::string option_name ) const;
+    /**
+     * @brief Get the value for an option without copying it
+     * @param option_name Parameter to look up
+     * @returns A view on the value of the option key. Returns an empty view, if the option for option_name is not found in this class or no value is set for this key
+     */
+    StringView view( const std::string& option_name ) const;
+    /**
+     * @brief Get the converted value of an option by its id
+     * @param id The id of the option as defined by CmdLineArguments::option_id
+     * @returns The slot of the option
+     * @throws std::out_of_range If there is no option with this id
+     */
+    const Value& value( uint32_t id ) const;
+    /**
+     * @brief Get the n-th value given for an option
+     * @param id The id of the option as defined by CmdLineArguments::option_id
+     * @param appearence The number of the occurrence, starting with 1. 0 requests the last value like value does.
+     * @returns The slot of the requested occurrence
+     * @throws std::out_of_range If there is no option with this id or it was given less than appearence times
+     */
+    const Value& occurrence( uint32_t id, unsigned int appearence ) const;
+    /**
+     * @brief Get all values given for an option without copying them
+     * @param id The id of the option as defined by CmdLineArguments::option_id
+     * @returns A range over the values in the order they were given. It stays valid until this class is modified.
+     */
+    Occurrences occurrences( uint32_t id ) const;
     /**
      * @brief Get the specified action, if any
      * @returns The specified action or an empty string, if no action was specified
@@ -96,14 +333,28 @@ public:
     
     /**
      * @brief Set last positional strings from command line parameters
-     * @param last_positionals The strings that are defined for the last postitional argument
+     * @param last_positionals_list Views on the strings that are defined for the last postitional argument
+     * @note The views are copied, the vector may be changed afterwards. The viewed strings have to outlive this class.
+     */
+    void set_last_positionals( const std::vector< StringView >& last_positionals_list );
+    /**
+     * @brief Set last positional strings from a range of command line parameters
+     * @param first The first view of the range
+     * @param last Behind the last view of the range
+     * @warning The range is not copied. It has to outlive this class.
      */
-    void set_last_positionals( std::vector< std::string > last_positionals_list );
+    void set_last_positionals( const StringView* first, const StringView* last );
     /**
      * @brief Get the list of the last positional parameters
      * @returns A vector containing strings with the last positional parameters
+     * @note This copies every parameter. last_positionals does not.
      */
     std::vector< std::string > get_last_positionals() const;
+    /**
+     * @brief Get the last positional parameters without copying them
+     * @returns A slice of the parsed parameters
+     */
+    const ArgvSlice& last_positionals() const;
     
     /**
      * @brief Test, if an option has an value specified
@@ -0,0 +1,119 @@
+/**
+ * @file parsestats.hpp
+ * @brief A file that defines the statistics collected while parsing
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief What the last parse cost, phase by phase
+ *
+ * Only collected, if CMDLINECPP_PARSE_STATS is defined in config.hpp and the collection is enabled with
+ * Parser::set_parse_stats_enabled. Times are wall-clock nanoseconds.
+ */
+struct ParseStats {
+    /**
+     * @brief True, if the statistics were collected for the last parse
+     */
+    bool collected;
+    /**
+     * @brief The time to build the indices of the definitions, 0 if they were frozen already
+     */
+    uint64_t freeze_ns;
+    /**
+     * @brief The time to split the command line into parameters, i.e. to expand the response files
+     */
+    uint64_t tokenize_ns;
+    /**
+     * @brief The time to tell options, values, actions and positional arguments apart
+     */
+    uint64_t classify_ns;
+    /**
+     * @brief The time to convert the values to their data types
+     */
+    uint64_t convert_ns;
+    /**
+     * @brief The time to check the positional arguments and to apply the environment and the config file
+     */
+    uint64_t validate_ns;
+    /**
+     * @brief The time of the whole parse
+     */
+    uint64_t total_ns;
+    /**
+     * @brief The number of parameters without the program name, after the response files were expanded
+     */
+    size_t tokens;
+    /**
+     * @brief The number of parameters, that were regular options
+     */
+    size_t options;
+    /**
+     * @brief The number of index slots compared by all lookups
+     */
+    uint64_t lookup_probes;
+    /**
+     * @brief The number of allocations from the arena of the parse state during this parse
+     * @note 0 once the slots of an earlier parse with the same definitions are reused
+     */
+    size_t allocations;
+    /**
+     * @brief The number of bytes allocated from the arena of the parse state during this parse, which holds the parameter store
+     */
+    size_t allocated_bytes;
+    /**
+     * @brief The memory held by the definitions and their indices, see CmdLineArguments::memory_footprint
+     */
+    size_t schema_bytes;
+    /**
+     * @brief The memory the arena of the parse state holds from the system
+     */
+    size_t parameter_bytes;
+
+    ParseStats()
+        :   collected( false )
+        ,   freeze_ns( 0 )
+        ,   tokenize_ns( 0 )
+        ,   classify_ns( 0 )
+        ,   convert_ns( 0 )
+        ,   validate_ns( 0 )
+        ,   total_ns( 0 )
+        ,   tokens( 0 )
+        ,   options( 0 )
+        ,   lookup_probes( 0 )
+        ,   allocations( 0 )
+        ,   allocated_bytes( 0 )
+        ,   schema_bytes( 0 )
+        ,   parameter_bytes( 0 )
+    {}
+};
+
+
+} // namespace cmdlinecpp
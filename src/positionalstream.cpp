@@ -0,0 +1,268 @@
+/**
+ * @file positionalstream.cpp
+ * @brief A file that defines a source of positional parameters that are read while the program runs
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+#include "positionalstream.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief The size of the block buffer for pipes and stdin
+ */
+const size_t block_size = 64 * 1024;
+
+} // namespace
+
+
+PositionalStream::PositionalStream( Data::Type data_type )
+    :   m_type( data_type )
+    ,   m_separator( '\n' )
+    ,   m_slice()
+    ,   m_slice_index( 0 )
+    ,   m_mapped()
+    ,   m_file( nullptr )
+    ,   m_owns_file( false )
+    ,   m_eof( false )
+    ,   m_buffer()
+    ,   m_begin( 0 )
+    ,   m_end( 0 )
+    ,   m_count( 0 )
+{}
+
+
+PositionalStream::PositionalStream( const ArgvSlice& slice, Data::Type data_type )
+    :   PositionalStream( data_type )
+{
+    m_slice = slice;
+}
+
+
+PositionalStream::PositionalStream( PositionalStream&& other )
+    :   m_type( other.m_type )
+    ,   m_separator( other.m_separator )
+    ,   m_slice( other.m_slice )
+    ,   m_slice_index( other.m_slice_index )
+    ,   m_mapped( std::move( other.m_mapped ) )
+    ,   m_file( other.m_file )
+    ,   m_owns_file( other.m_owns_file )
+    ,   m_eof( other.m_eof )
+    ,   m_buffer( std::move( other.m_buffer ) )
+    ,   m_begin( other.m_begin )
+    ,   m_end( other.m_end )
+    ,   m_count( other.m_count )
+{
+    other.m_file = nullptr;
+    other.m_owns_file = false;
+}
+
+
+PositionalStream& PositionalStream::operator=( PositionalStream&& other ) {
+    if ( this != &other ) {
+        this->close();
+        m_type = other.m_type;
+        m_separator = other.m_separator;
+        m_slice = other.m_slice;
+        m_slice_index = other.m_slice_index;
+        m_mapped = std::move( other.m_mapped );
+        m_file = other.m_file;
+        m_owns_file = other.m_owns_file;
+        m_eof = other.m_eof;
+        m_buffer = std::move( other.m_buffer );
+        m_begin = other.m_begin;
+        m_end = other.m_end;
+        m_count = other.m_count;
+        other.m_file = nullptr;
+        other.m_owns_file = false;
+    }
+    return *this;
+}
+
+
+PositionalStream::~PositionalStream() {
+    this->close();
+}
+
+
+void PositionalStream::close() {
+    if ( m_file != nullptr && m_owns_file ) {
+        std::fclose( m_file );
+    }
+    m_file = nullptr;
+    m_owns_file = false;
+}
+
+
+void PositionalStream::open( const std::string& path, Separator separator ) {
+    this->close();
+    m_mapped.reset();
+    m_slice = ArgvSlice();
+    m_slice_index = 0;
+    m_separator = ( separator == Separator::Nul ) ? '\0' : '\n';
+    m_eof = false;
+    m_begin = 0;
+    m_end = 0;
+
+    if ( path == "-" ) {
+        m_file = stdin;
+        return;
+    }
+
+    struct stat status;
+    if ( stat( path.c_str(), &status ) == 0 && S_ISREG( status.st_mode ) ) {
+        // A regular file is mapped, nothing is copied
+        std::unique_ptr< MappedFile > mapped( new MappedFile() );
+        if ( mapped->open( path ) ) {
+            m_mapped = std::move( mapped );
+            m_end = m_mapped->size();
+            return;
+        }
+    }
+
+    m_file = std::fopen( path.c_str(), "rb" );
+    if ( m_file == nullptr ) {
+        throw std::runtime_error("Could not open '" + path + "'.");
+    }
+    m_owns_file = true;
+}
+
+
+bool PositionalStream::fill() {
+    if ( m_eof ) {
+        return false;
+    }
+
+    // Keep the part of an item, that was read already, at the front
+    if ( m_begin > 0 ) {
+        std::memmove( m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin );
+        m_end -= m_begin;
+        m_begin = 0;
+    }
+    if ( m_buffer.empty() ) {
+        m_buffer.resize( block_size );
+    } else if ( m_end == m_buffer.size() ) {
+        // Only an item longer than the buffer makes it grow
+        m_buffer.resize( m_buffer.size() * 2 );
+    }
+
+#ifdef __unix__
+    // read returns what is there, so the first items are available before the pipe is full
+    ssize_t bytes = 0;
+    do {
+        bytes = read( fileno( m_file ), m_buffer.data() + m_end, m_buffer.size() - m_end );
+    } while ( bytes < 0 && errno == EINTR );
+    if ( bytes < 0 ) {
+        throw std::runtime_error(std::string("Could not read the positional parameters: ") + std::strerror( errno ));
+    }
+#else
+    const size_t bytes = std::fread( m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file );
+    if ( bytes == 0 && std::ferror( m_file ) ) {
+        throw std::runtime_error("Could not read the positional parameters.");
+    }
+#endif
+
+    if ( bytes == 0 ) {
+        m_eof = true;
+        return false;
+    }
+    m_end += static_cast< size_t >( bytes );
+    return true;
+}
+
+
+bool PositionalStream::next( StringView& item ) {
+    if ( !m_mapped && m_file == nullptr ) {
+        if ( m_slice_index >= m_slice.size() ) {
+            return false;
+        }
+        item = m_slice[ m_slice_index++ ];
+        ++m_count;
+        return true;
+    }
+
+    while ( true ) {
+        const char* data = m_mapped ? m_mapped->data() : m_buffer.data();
+        const void* separator = ( m_begin < m_end ) ? std::memchr( data + m_begin, m_separator, m_end - m_begin ) : nullptr;
+
+        size_t first = m_begin;
+        size_t last = 0;
+        if ( separator != nullptr ) {
+            last = static_cast< const char* >( separator ) - data;
+            m_begin = last + 1;
+        } else if ( m_mapped || m_eof ) {
+            if ( m_begin == m_end ) {
+                return false;
+            }
+            // The last item has no separator behind it
+            last = m_end;
+            m_begin = m_end;
+        } else {
+            this->fill();
+            continue;
+        }
+
+        if ( m_separator == '\n' && last > first && data[last-1] == '\r' ) {
+            --last;
+        }
+        if ( last == first ) {
+            continue;
+        }
+
+        item = StringView( data + first, last - first );
+        ++m_count;
+        return true;
+    }
+}
+
+
+bool PositionalStream::next( Value& value ) {
+    StringView item;
+    if ( !this->next( item ) ) {
+        return false;
+    }
+    value = Value::from_text( m_type, item );
+    return true;
+}
+
+
+size_t PositionalStream::count() const {
+    return m_count;
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,175 @@
+/**
+ * @file positionalstream.hpp
+ * @brief A file that defines a source of positional parameters that are read while the program runs
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arguments.hpp"
+#include "parameters.hpp"
+#include "responsefile.hpp"
+#include "stringview.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief Reads the items of the last positional list one by one, from the command line, a file or stdin
+ *
+ * A regular file is mapped into memory. Other files like pipes and stdin are read in blocks into one
+ * buffer that is reused, so the program can start with the first items before the input ends and the
+ * memory does not grow with the input.
+ */
+class PositionalStream {
+public:
+    /**
+     * @brief How the items are separated in a file
+     */
+    enum class Separator {
+        /// One item per line, like the output of find
+        Newline,
+        /// Every item ends with a NUL character, like the output of find -print0
+        Nul
+    };
+
+private:
+    /**
+     * @brief The data type every item is converted to
+     */
+    Data::Type m_type;
+    /**
+     * @brief The separator of the items in a file
+     */
+    char m_separator;
+    /**
+     * @brief The items from the command line, if the stream does not read a file
+     */
+    ArgvSlice m_slice;
+    /**
+     * @brief The index of the next item in m_slice
+     */
+    size_t m_slice_index;
+    /**
+     * @brief The mapped file, if the stream reads a regular file
+     */
+    std::unique_ptr< MappedFile > m_mapped;
+    /**
+     * @brief The file, if the stream reads from a pipe or stdin, or nullptr
+     */
+    std::FILE* m_file;
+    /**
+     * @brief True, if m_file was opened by this stream and has to be closed
+     */
+    bool m_owns_file;
+    /**
+     * @brief True, if the end of m_file was reached
+     */
+    bool m_eof;
+    /**
+     * @brief The block buffer for m_file
+     */
+    std::vector< char > m_buffer;
+    /**
+     * @brief The first byte of the input, that was not returned as item yet, in m_buffer or the mapped file
+     */
+    size_t m_begin;
+    /**
+     * @brief Behind the last byte of the input in the buffer
+     */
+    size_t m_end;
+    /**
+     * @brief The number of items returned so far
+     */
+    size_t m_count;
+
+    /**
+     * @brief Read the next block into the buffer and keep the part of the item not returned yet
+     * @returns False, if there is no more input
+     */
+    bool fill();
+    /**
+     * @brief Close the file, if this stream opened it
+     */
+    void close();
+
+public:
+    /**
+     * @brief Constructor. Constructs a stream without items.
+     * @param data_type The data type every item is converted to by next( Value& )
+     */
+    explicit PositionalStream( Data::Type data_type = Data::Type::String );
+    /**
+     * @brief Constructor. Constructs a stream over parameters of the command line.
+     * @param slice The parameters, e.g. CmdLineParameters::last_positionals. They have to outlive the stream.
+     * @param data_type The data type every item is converted to by next( Value& )
+     */
+    PositionalStream( const ArgvSlice& slice, Data::Type data_type = Data::Type::String );
+    PositionalStream( PositionalStream&& other );
+    PositionalStream& operator=( PositionalStream&& other );
+    /**
+     * @brief Destructor. Closes the file.
+     */
+    ~PositionalStream();
+
+    PositionalStream( const PositionalStream& ) = delete;
+    PositionalStream& operator=( const PositionalStream& ) = delete;
+
+    /**
+     * @brief Read the items from a file instead
+     * @param path The path of the file or "-" for stdin
+     * @param separator How the items are separated
+     * @throws std::runtime_error If the file can not be opened
+     */
+    void open( const std::string& path, Separator separator = Separator::Newline );
+
+    /**
+     * @brief Get the next item
+     * @param item Is set to a view on the next item. Empty lines are skipped and a '\r' at the end of a line is removed.
+     * @returns False, if there are no more items
+     * @warning The view is valid until the next call, if the stream reads from a pipe or stdin
+     * @throws std::runtime_error If reading fails
+     */
+    bool next( StringView& item );
+    /**
+     * @brief Get the next item converted to the data type of the stream
+     * @param value Is set to the converted item
+     * @returns False, if there are no more items
+     * @throws TypeError If the item can not be converted
+     * @throws std::runtime_error If reading fails
+     */
+    bool next( Value& value );
+    /**
+     * @brief Get the number of items returned so far
+     * @returns The number of items
+     */
+    size_t count() const;
+};
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,304 @@
+/**
+ * @file responsefile.cpp
+ * @brief A file that defines the expansion of response files like @args.rsp
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+
+#include "index.hpp"
+#endif
+
+#include "arguments.hpp"
+#include "exceptions.hpp"
+#include "responsefile.hpp"
+
+
+namespace cmdlinecpp {
+
+
+MappedFile::MappedFile()
+    :   m_data( nullptr )
+    ,   m_size( 0 )
+    ,   m_device( 0 )
+    ,   m_inode( 0 )
+    ,   m_buffer()
+{}
+
+
+MappedFile::~MappedFile() {
+#ifdef __unix__
+    if ( m_data != nullptr && m_size > 0 ) {
+        munmap( m_data, m_size );
+    }
+#endif
+}
+
+
+#ifdef __unix__
+
+bool MappedFile::open( const std::string& path ) {
+    // Non-blocking, so a named pipe does not wait for a writer. It changes nothing for regular files.
+    const int fd = ::open( path.c_str(), O_RDONLY | O_NONBLOCK );
+    if ( fd < 0 ) {
+        return false;
+    }
+
+    // Directories, devices and pipes are no files to map
+    struct stat status;
+    if ( fstat( fd, &status ) != 0 || !S_ISREG( status.st_mode ) ) {
+        close( fd );
+        return false;
+    }
+
+    try {
+        this->open( fd, path );
+    } catch ( exceptions::ResponseFileError& ) {
+        close( fd );
+        throw;
+    }
+
+    close( fd );
+    return true;
+}
+
+
+void MappedFile::open( int fd, const std::string& name ) {
+    struct stat status;
+    if ( fstat( fd, &status ) != 0 ) {
+        throw exceptions::ResponseFileError("Could not read the file '" + name + "'.");
+    }
+    m_device = static_cast< uint64_t >( status.st_dev );
+    m_inode = static_cast< uint64_t >( status.st_ino );
+    m_size = static_cast< size_t >( status.st_size );
+
+    if ( m_size > 0 ) {
+        // Private and writable, so the parameters can be unquoted in place without changing the file
+        void* data = mmap( nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+        if ( data == MAP_FAILED ) {
+            m_size = 0;
+            throw exceptions::ResponseFileError("Could not map the file '" + name + "'.");
+        }
+        m_data = static_cast< char* >( data );
+        madvise( m_data, m_size, MADV_SEQUENTIAL );
+    }
+}
+
+#else
+
+bool MappedFile::open( const std::string& path ) {
+    std::ifstream file( path.c_str(), std::ios::in | std::ios::binary );
+    if ( !file ) {
+        return false;
+    }
+
+    // Directories and devices can be opened on some systems, but not read like a file
+    file.seekg( 0, std::ios::end );
+    const std::streamoff size = file.tellg();
+    file.seekg( 0, std::ios::beg );
+    if ( size < 0 ) {
+        return false;
+    }
+    m_buffer.resize( static_cast< size_t >( size ) );
+    if ( !m_buffer.empty() && !file.read( m_buffer.data(), m_buffer.size() ) ) {
+        m_buffer.clear();
+        return false;
+    }
+    m_size = m_buffer.size();
+
+    // Without inode numbers the path identifies the file
+    m_device = 0;
+    m_inode = NameIndex::hash( path.data(), path.size() );
+    return true;
+}
+
+#endif
+
+
+char* MappedFile::data() {
+    return m_buffer.empty() ? m_data : m_buffer.data();
+}
+
+
+size_t MappedFile::size() const {
+    return m_size;
+}
+
+
+bool MappedFile::is_same_file( const MappedFile& other ) const {
+    return m_device == other.m_device && m_inode == other.m_inode;
+}
+
+
+ResponseFileTokenizer::ResponseFileTokenizer( char* data, size_t size )
+    :   m_current( data )
+    ,   m_end( data + size )
+{}
+
+
+bool ResponseFileTokenizer::next( StringView& token ) {
+    char* p = m_current;
+    while ( p != m_end && ( *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == '\f' || *p == '\v' ) ) {
+        ++p;
+    }
+    if ( p == m_end ) {
+        m_current = p;
+        return false;
+    }
+
+    char* const begin = p;
+    char* w = p;
+    char quote = 0;
+    while ( p != m_end ) {
+        const char c = *p;
+        if ( quote == '\'' ) {
+            if ( c == '\'' ) {
+                quote = 0;
+            } else {
+                *w++ = c;
+            }
+            ++p;
+        } else if ( c == '\\' ) {
+            // Escapes the next character, also inside double quotes
+            if ( p + 1 != m_end ) {
+                *w++ = p[1];
+                p += 2;
+            } else {
+                ++p;
+            }
+        } else if ( quote == '"' ) {
+            if ( c != '"' ) {
+                *w++ = c;
+            } else {
+                quote = 0;
+            }
+            ++p;
+        } else if ( c == '"' || c == '\'' ) {
+            quote = c;
+            ++p;
+        } else if ( c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v' ) {
+            break;
+        } else {
+            *w++ = c;
+            ++p;
+        }
+    }
+
+    if ( quote != 0 ) {
+        throw exceptions::ResponseFileError(std::string("Missing closing ") + quote + " in response file.");
+    }
+
+    token = StringView( begin, w - begin );
+    m_current = p;
+    return true;
+}
+
+
+ResponseFiles::ResponseFiles()
+    :   m_files()
+    ,   m_stack()
+{}
+
+
+bool ResponseFiles::expand( const StringView* argv, size_t argc, std::vector< StringView >& expanded ) {
+    size_t first = 1;
+    while ( first < argc && ( argv[first].empty() || argv[first][0] != '@' ) ) {
+        if ( argv[first] == END_OF_OPTIONS ) {
+            return false;
+        }
+        ++first;
+    }
+    if ( first >= argc ) {
+        return false;
+    }
+
+    expanded.clear();
+    expanded.reserve( argc );
+    expanded.insert( expanded.end(), argv, argv + first );
+    for ( size_t a = first; a < argc; a++ ) {
+        if ( argv[a] == END_OF_OPTIONS ) {
+            // Parameters behind -- are never expanded
+            expanded.insert( expanded.end(), argv + a, argv + argc );
+            break;
+        }
+        if ( !argv[a].empty() && argv[a][0] == '@' ) {
+            this->expand_file( argv[a], expanded );
+        } else {
+            expanded.push_back( argv[a] );
+        }
+    }
+    return true;
+}
+
+
+void ResponseFiles::expand_file( const StringView& argument, std::vector< StringView >& expanded ) {
+    const std::string path = argument.substr( 1 ).str();
+
+    std::unique_ptr< MappedFile > file( new MappedFile() );
+    if ( !file->open( path ) ) {
+        expanded.push_back( argument );
+        return;
+    }
+    for ( size_t s = 0; s < m_stack.size(); s++ ) {
+        if ( m_stack[s]->is_same_file( *file ) ) {
+            throw exceptions::ResponseFileError("The response file '" + path + "' includes itself.");
+        }
+    }
+
+    m_files.push_back( std::move( file ) );
+    MappedFile& mapped = *m_files.back();
+    m_stack.push_back( &mapped );
+
+    try {
+        ResponseFileTokenizer tokenizer( mapped.data(), mapped.size() );
+        StringView token;
+        while ( tokenizer.next( token ) ) {
+            if ( !token.empty() && token[0] == '@' ) {
+                this->expand_file( token, expanded );
+            } else {
+                expanded.push_back( token );
+            }
+        }
+    } catch ( exceptions::ResponseFileError& ) {
+        m_stack.pop_back();
+        throw;
+    }
+
+    m_stack.pop_back();
+}
+
+
+void ResponseFiles::clear() {
+    m_files.clear();
+    m_stack.clear();
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,166 @@
+/**
+ * @file responsefile.hpp
+ * @brief A file that defines the expansion of response files like @args.rsp
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "stringview.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief A private, writable mapping of a whole file
+ * @note Changes are not written back to the file. On systems without mmap the file is read into memory instead.
+ */
+class MappedFile {
+    char* m_data;
+    size_t m_size;
+    uint64_t m_device;
+    uint64_t m_inode;
+    std::vector< char > m_buffer;
+
+public:
+    MappedFile();
+    /**
+     * @brief Destructor. Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    /**
+     * @brief Map a file
+     * @param path The path of the file
+     * @returns False, if the file can not be opened or is no regular file, e.g. a directory
+     * @throws ResponseFileError If the file was opened, but can not be mapped
+     */
+    bool open( const std::string& path );
+#ifdef __unix__
+    /**
+     * @brief Map a file that is already open, e.g. an inherited descriptor or a memfd
+     * @param fd The file descriptor. It is not closed.
+     * @param name The name of the file for error messages
+     * @throws ResponseFileError If the file can not be mapped
+     */
+    void open( int fd, const std::string& name );
+#endif
+
+    /**
+     * @brief Get the contents of the file
+     * @returns A pointer to the first byte. The contents may be modified.
+     */
+    char* data();
+    /**
+     * @brief Get the size of the file
+     * @returns The size in bytes
+     */
+    size_t size() const;
+    /**
+     * @brief Test, if this is the same file as another one, even if it was opened by another path
+     * @param other The other file
+     * @returns True, if both are the same file
+     */
+    bool is_same_file( const MappedFile& other ) const;
+};
+
+
+/**
+ * @brief Splits the contents of a response file into parameters in place
+ *
+ * Parameters are separated by whitespace. Single quotes, double quotes and a backslash in front of a
+ * character keep whitespace in a parameter, like gcc does. Inside single quotes a backslash is no escape.
+ * The unquoted parameters are written over the contents, as they are never longer.
+ */
+class ResponseFileTokenizer {
+    char* m_current;
+    char* m_end;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param data The contents of the response file
+     * @param size The size of the contents
+     */
+    ResponseFileTokenizer( char* data, size_t size );
+
+    /**
+     * @brief Get the next parameter
+     * @param token Is set to a view on the next parameter
+     * @returns False, if there are no more parameters
+     * @throws ResponseFileError If a quote is not closed
+     */
+    bool next( StringView& token );
+};
+
+
+/**
+ * @brief Replaces parameters like @file by the parameters in the file and keeps the files mapped as long as the parameters are used
+ */
+class ResponseFiles {
+    /**
+     * @brief All files mapped since the last clear. The expanded parameters point into them.
+     */
+    std::vector< std::unique_ptr< MappedFile > > m_files;
+    /**
+     * @brief The files that are expanded at the moment, to detect a file that includes itself
+     */
+    std::vector< const MappedFile* > m_stack;
+
+    /**
+     * @brief Expand one parameter, that starts with @
+     * @param argument The parameter
+     * @param expanded The list to add the parameters of the file to
+     */
+    void expand_file( const StringView& argument, std::vector< StringView >& expanded );
+
+public:
+    ResponseFiles();
+
+    /**
+     * @brief Expand all response files in a list of parameters
+     * @param argv The parameters. The first one is the program name and is never expanded.
+     * @param argc The number of parameters
+     * @param expanded Is set to the parameters with every @file replaced by the parameters in the file
+     * @returns False, if no parameter starts with @. Then expanded is not touched.
+     * @throws ResponseFileError If a file includes itself, directly or through other files, or has an open quote
+     * @note A parameter @file, where file can not be opened or is no regular file, is kept as it is, like gcc does. Parameters behind -- are not expanded.
+     */
+    bool expand( const StringView* argv, size_t argc, std::vector< StringView >& expanded );
+    /**
+     * @brief Unmap all files
+     * @warning Parameters returned by expand are invalid afterwards
+     */
+    void clear();
+};
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,431 @@
+/**
+ * @file schemacache.cpp
+ * @brief A file that defines a cache file for frozen option definitions, that makes defining thousands of options at startup cheap
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "index.hpp"
+#include "schemacache.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief The first bytes of every schema cache
+ */
+const char schema_magic[8] = { 'C', 'M', 'D', 'L', 'S', 'C', 'H', 'M' };
+/**
+ * @brief Written in native byte order, so a cache of another byte order is detected
+ */
+const uint32_t schema_byte_order = 0x01020304;
+
+/**
+ * @brief A text as offset into the strings section
+ */
+struct SchemaText {
+    uint32_t offset;
+    uint32_t length;
+};
+
+/**
+ * @brief The header of a schema cache. The sections follow in this order: options, actions, the slots of the
+ * token, name, action and environment index, then the strings.
+ */
+struct SchemaHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t stamp_hash;
+    uint64_t checksum;
+    uint32_t regular_count;
+    uint32_t positional_count;
+    uint32_t action_count;
+    uint32_t token_slots;
+    uint32_t name_slots;
+    uint32_t action_slots;
+    uint32_t environment_slots;
+    uint32_t padding;
+    SchemaText positional_source;
+    SchemaText environment_prefix;
+    uint64_t strings_size;
+};
+
+struct SchemaOption {
+    SchemaText name;
+    SchemaText short_name;
+    SchemaText help_text;
+    SchemaText environment_variable;
+    uint32_t data_type;
+    uint32_t padding;
+};
+
+struct SchemaAction {
+    SchemaText name;
+    SchemaText help_text;
+};
+
+/**
+ * @brief A slot of a NameIndex. The key is not stored, it is the short specifier, if is_short is set, and
+ * the name of the definition with the id value otherwise.
+ */
+struct SchemaSlot {
+    uint64_t hash;
+    uint32_t length;
+    uint32_t value;
+    uint32_t is_used;
+    uint32_t is_short;
+};
+
+static_assert( sizeof( SchemaHeader ) % 8 == 0, "The header has to keep the sections aligned." );
+static_assert( sizeof( SchemaOption ) == 40 && sizeof( SchemaAction ) == 16 && sizeof( SchemaSlot ) == 24, "The layout must not change within a version." );
+
+
+/**
+ * @brief A checksum over a range, that reads 8 bytes at a time
+ */
+uint64_t checksum( const char* data, size_t size ) {
+    uint64_t h = 14695981039346656037ULL;
+    size_t c = 0;
+    for ( ; c + 8 <= size; c += 8 ) {
+        uint64_t word;
+        std::memcpy( &word, data + c, sizeof( word ) );
+        h = ( h ^ word ) * 0x100000001b3ULL;
+        h ^= h >> 29;
+    }
+    for ( ; c < size; c++ ) {
+        h = ( h ^ static_cast< unsigned char >( data[c] ) ) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+
+/**
+ * @brief Writes the sections of a schema cache
+ */
+class SchemaWriter {
+    std::vector< char >& m_blob;
+    std::vector< char > m_strings;
+
+public:
+    explicit SchemaWriter( std::vector< char >& blob )
+        :   m_blob( blob )
+        ,   m_strings()
+    {}
+
+    SchemaText text( const std::string& text ) {
+        SchemaText result;
+        result.offset = static_cast< uint32_t >( m_strings.size() );
+        result.length = static_cast< uint32_t >( text.length() );
+        m_strings.insert( m_strings.end(), text.begin(), text.end() );
+        return result;
+    }
+
+    void append( const void* data, size_t size ) {
+        const char* bytes = static_cast< const char* >( data );
+        m_blob.insert( m_blob.end(), bytes, bytes + size );
+    }
+
+    void option( const Option& option ) {
+        SchemaOption stored;
+        std::memset( &stored, 0, sizeof( stored ) );
+        stored.name = this->text( option.option() );
+        stored.short_name = this->text( option.option_short() );
+        stored.help_text = this->text( option.help_text() );
+        stored.environment_variable = this->text( option.environment_variable() );
+        stored.data_type = static_cast< uint32_t >( option.dataType() );
+        this->append( &stored, sizeof( stored ) );
+    }
+
+    /**
+     * @brief Append the slots of an index
+     * @param index The index
+     * @param short_names The short specifiers the index may contain or nullptr, if it only contains names
+     * @returns The number of slots
+     */
+    uint32_t slots( const NameIndex& index, const std::vector< Option >* short_names ) {
+        const std::vector< NameIndex::Slot >& slots = index.slots();
+        for ( size_t s = 0; s < slots.size(); s++ ) {
+            SchemaSlot stored;
+            std::memset( &stored, 0, sizeof( stored ) );
+            if ( slots[s].key != nullptr ) {
+                stored.hash = slots[s].hash;
+                stored.length = slots[s].length;
+                stored.value = slots[s].value;
+                stored.is_used = 1;
+                stored.is_short = ( short_names != nullptr
+                                 && ( *short_names )[ slots[s].value ].option_short().data() == slots[s].key ) ? 1 : 0;
+            }
+            this->append( &stored, sizeof( stored ) );
+        }
+        return static_cast< uint32_t >( slots.size() );
+    }
+
+    const std::vector< char >& strings() const {
+        return m_strings;
+    }
+};
+
+
+/**
+ * @brief Reads the sections of a schema cache
+ */
+class SchemaReader {
+    const char* m_strings;
+    uint64_t m_strings_size;
+
+public:
+    SchemaReader( const char* strings, uint64_t strings_size )
+        :   m_strings( strings )
+        ,   m_strings_size( strings_size )
+    {}
+
+    bool is_valid( const SchemaText& text ) const {
+        return static_cast< uint64_t >( text.offset ) + text.length <= m_strings_size;
+    }
+
+    std::string text( const SchemaText& text ) const {
+        return std::string( m_strings + text.offset, text.length );
+    }
+};
+
+
+/**
+ * @brief Turn stored slots into the slots of a NameIndex
+ * @param data The first stored slot
+ * @param count The number of slots
+ * @param key The function that returns the key of a definition by the value of a slot
+ * @param slots Is set to the slots
+ * @returns False, if a value is out of range
+ */
+template< typename KeyOf >
+bool load_slots( const char* data, size_t count, uint32_t value_count, KeyOf key, std::vector< NameIndex::Slot >& slots ) {
+    slots.resize( count );
+    for ( size_t s = 0; s < count; s++ ) {
+        SchemaSlot stored;
+        std::memcpy( &stored, data + s * sizeof( SchemaSlot ), sizeof( stored ) );
+
+        NameIndex::Slot& slot = slots[s];
+        slot.hash = stored.hash;
+        slot.length = stored.length;
+        slot.value = stored.value;
+        slot.key = nullptr;
+        if ( stored.is_used ) {
+            if ( stored.value >= value_count ) {
+                return false;
+            }
+            slot.key = key( stored.value, stored.is_short != 0 );
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+
+void SchemaCache::write( const CmdLineArguments& arguments
+                       , const std::string& stamp
+                       , std::vector< char >& blob
+) {
+    if ( !arguments.is_frozen() ) {
+        throw std::logic_error("The definitions have to be frozen before they are written to a schema cache.");
+    }
+
+    SchemaHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, schema_magic, sizeof( header.magic ) );
+    header.version = SchemaCache::version;
+    header.byte_order = schema_byte_order;
+    header.stamp_hash = NameIndex::hash( stamp.data(), stamp.length() );
+    header.regular_count = static_cast< uint32_t >( arguments.m_options.size() );
+    header.positional_count = static_cast< uint32_t >( arguments.m_positionals.size() );
+    header.action_count = static_cast< uint32_t >( arguments.m_actions.size() );
+
+    blob.clear();
+    blob.resize( sizeof( header ), 0 );
+    SchemaWriter writer( blob );
+
+    for ( size_t o = 0; o < arguments.m_options.size(); o++ ) {
+        writer.option( arguments.m_options[o] );
+    }
+    for ( size_t p = 0; p < arguments.m_positionals.size(); p++ ) {
+        writer.option( arguments.m_positionals[p] );
+    }
+    for ( size_t a = 0; a < arguments.m_actions.size(); a++ ) {
+        SchemaAction stored;
+        stored.name = writer.text( arguments.m_actions[a].name() );
+        stored.help_text = writer.text( arguments.m_actions[a].help_text() );
+        writer.append( &stored, sizeof( stored ) );
+    }
+
+    header.token_slots = writer.slots( arguments.m_token_index, &arguments.m_options );
+    header.name_slots = writer.slots( arguments.m_name_index, nullptr );
+    header.action_slots = writer.slots( arguments.m_action_index, nullptr );
+    header.environment_slots = writer.slots( arguments.m_environment_index, nullptr );
+
+    header.positional_source = writer.text( arguments.m_positional_source );
+    header.environment_prefix = writer.text( arguments.m_environment_prefix );
+    header.strings_size = writer.strings().size();
+    blob.insert( blob.end(), writer.strings().begin(), writer.strings().end() );
+
+    header.checksum = checksum( blob.data() + sizeof( header ), blob.size() - sizeof( header ) );
+    std::memcpy( blob.data(), &header, sizeof( header ) );
+}
+
+
+bool SchemaCache::read( const char* data
+                      , size_t size
+                      , const std::string& stamp
+                      , CmdLineArguments& arguments
+) {
+    SchemaHeader header;
+    if ( size < sizeof( header ) ) {
+        return false;
+    }
+    std::memcpy( &header, data, sizeof( header ) );
+
+    if ( std::memcmp( header.magic, schema_magic, sizeof( header.magic ) ) != 0
+      || header.version != SchemaCache::version
+      || header.byte_order != schema_byte_order
+      || header.stamp_hash != NameIndex::hash( stamp.data(), stamp.length() )
+    ) {
+        return false;
+    }
+
+    const size_t options_offset = sizeof( header );
+    const size_t option_count = static_cast< size_t >( header.regular_count ) + header.positional_count;
+    const size_t actions_offset = options_offset + option_count * sizeof( SchemaOption );
+    const size_t token_offset = actions_offset + static_cast< size_t >( header.action_count ) * sizeof( SchemaAction );
+    const size_t name_offset = token_offset + static_cast< size_t >( header.token_slots ) * sizeof( SchemaSlot );
+    const size_t action_offset = name_offset + static_cast< size_t >( header.name_slots ) * sizeof( SchemaSlot );
+    const size_t environment_offset = action_offset + static_cast< size_t >( header.action_slots ) * sizeof( SchemaSlot );
+    const size_t strings_offset = environment_offset + static_cast< size_t >( header.environment_slots ) * sizeof( SchemaSlot );
+    if ( strings_offset > size
+      || size - strings_offset != header.strings_size
+      || checksum( data + sizeof( header ), size - sizeof( header ) ) != header.checksum
+    ) {
+        return false;
+    }
+
+    const SchemaReader reader( data + strings_offset, header.strings_size );
+    if ( !reader.is_valid( header.positional_source ) || !reader.is_valid( header.environment_prefix ) ) {
+        return false;
+    }
+
+    // Build everything aside, so arguments stays untouched, if the cache is refused
+    std::vector< Option > options;
+    std::vector< Option > positionals;
+    std::vector< Action > actions;
+    options.reserve( header.regular_count );
+    positionals.reserve( header.positional_count );
+    actions.reserve( header.action_count );
+
+    for ( size_t o = 0; o < option_count; o++ ) {
+        SchemaOption stored;
+        std::memcpy( &stored, data + options_offset + o * sizeof( SchemaOption ), sizeof( stored ) );
+        if ( !reader.is_valid( stored.name ) || !reader.is_valid( stored.short_name )
+          || !reader.is_valid( stored.help_text ) || !reader.is_valid( stored.environment_variable )
+          || stored.data_type > static_cast< uint32_t >( Data::Type::Void )
+        ) {
+            return false;
+        }
+
+        const Data::Type data_type = static_cast< Data::Type >( stored.data_type );
+        if ( o < header.regular_count ) {
+            options.push_back( Option( reader.text( stored.name ), reader.text( stored.short_name ), reader.text( stored.help_text ), data_type ) );
+            if ( stored.environment_variable.length > 0 ) {
+                options.back().from_environment( reader.text( stored.environment_variable ) );
+            }
+        } else {
+            positionals.push_back( Option( reader.text( stored.name ), reader.text( stored.help_text ), data_type ) );
+        }
+    }
+    for ( size_t a = 0; a < header.action_count; a++ ) {
+        SchemaAction stored;
+        std::memcpy( &stored, data + actions_offset + a * sizeof( SchemaAction ), sizeof( stored ) );
+        if ( !reader.is_valid( stored.name ) || !reader.is_valid( stored.help_text ) ) {
+            return false;
+        }
+        actions.push_back( Action( reader.text( stored.name ), reader.text( stored.help_text ) ) );
+    }
+
+    // The keys of the slots point into the definitions, which do not move anymore
+    std::vector< NameIndex::Slot > token_slots;
+    std::vector< NameIndex::Slot > name_slots;
+    std::vector< NameIndex::Slot > action_slots;
+    std::vector< NameIndex::Slot > environment_slots;
+    const uint32_t regular_count = header.regular_count;
+    const bool slots_valid =
+        load_slots( data + token_offset, header.token_slots, regular_count
+                  , [&options]( uint32_t value, bool is_short ) {
+                        return is_short ? options[value].option_short().data() : options[value].option().data();
+                    }
+                  , token_slots )
+     && load_slots( data + name_offset, header.name_slots, static_cast< uint32_t >( option_count )
+                  , [&options, &positionals, regular_count]( uint32_t value, bool ) {
+                        return value < regular_count ? options[value].option().data() : positionals[ value - regular_count ].option().data();
+                    }
+                  , name_slots )
+     && load_slots( data + action_offset, header.action_slots, header.action_count
+                  , [&actions]( uint32_t value, bool ) {
+                        return actions[value].name().data();
+                    }
+                  , action_slots )
+     && load_slots( data + environment_offset, header.environment_slots, regular_count
+                  , [&options]( uint32_t value, bool ) {
+                        return options[value].environment_variable().data();
+                    }
+                  , environment_slots );
+    if ( !slots_valid ) {
+        return false;
+    }
+
+    CmdLineArguments loaded;
+    loaded.m_options.swap( options );
+    loaded.m_positionals.swap( positionals );
+    loaded.m_actions.swap( actions );
+    try {
+        loaded.m_token_index.assign( std::move( token_slots ) );
+        loaded.m_name_index.assign( std::move( name_slots ) );
+        loaded.m_action_index.assign( std::move( action_slots ) );
+        loaded.m_environment_index.assign( std::move( environment_slots ) );
+    } catch ( std::invalid_argument& ) {
+        return false;
+    }
+    loaded.m_positional_source = reader.text( header.positional_source );
+    loaded.m_environment_prefix = reader.text( header.environment_prefix );
+    loaded.sort_names();
+    loaded.m_frozen = true;
+
+    arguments = std::move( loaded );
+    return true;
+}
+
+
+} // namespace cmdlinecpp
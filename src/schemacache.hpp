@@ -0,0 +1,80 @@
+/**
+ * @file schemacache.hpp
+ * @brief A file that defines a cache file for frozen option definitions, that makes defining thousands of options at startup cheap
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "arguments.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief Stores frozen option definitions together with their lookup indices in a blob and loads them back without rebuilding the indices
+ *
+ * The blob holds all options, actions and the hash tables built by CmdLineArguments::freeze. Loading it
+ * checks a checksum over the whole blob and a stamp chosen by the program, e.g. its version, so a cache
+ * written by another build is detected as stale. The definitions are created with the exact number of
+ * elements and the hash tables are copied as they are, so nothing is searched, hashed or probed.
+ */
+class SchemaCache {
+public:
+    /**
+     * @brief The version of the format. Blobs of other versions are stale.
+     */
+    static const uint32_t version = 1;
+
+    /**
+     * @brief Write frozen definitions into a blob
+     * @param arguments The definitions. They have to be frozen.
+     * @param stamp A text that changes, whenever the definitions in the program change, e.g. the version of the program
+     * @param blob Is set to the cache
+     * @throws std::logic_error If the definitions are not frozen
+     */
+    static void write( const CmdLineArguments& arguments
+                     , const std::string& stamp
+                     , std::vector< char >& blob );
+    /**
+     * @brief Replace definitions by the ones in a blob
+     * @param data The cache
+     * @param size The size of the cache in bytes
+     * @param stamp The stamp the cache has to be written with
+     * @param arguments Is set to the frozen definitions in the cache
+     * @returns False, if the blob is no cache, is corrupt or was written with another version or stamp. arguments is not touched then.
+     * @note Nothing points into data afterwards, so it can be unmapped.
+     */
+    static bool read( const char* data
+                    , size_t size
+                    , const std::string& stamp
+                    , CmdLineArguments& arguments );
+};
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,338 @@
+/**
+ * @file snapshot.cpp
+ * @brief A file that defines a binary snapshot of parsed parameters, that other processes can load without parsing
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "exceptions.hpp"
+#include "index.hpp"
+#include "snapshot.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief The first bytes of every snapshot
+ */
+const char snapshot_magic[8] = { 'C', 'M', 'D', 'L', 'S', 'N', 'A', 'P' };
+/**
+ * @brief Written in native byte order, so a snapshot of another byte order is detected
+ */
+const uint32_t snapshot_byte_order = 0x01020304;
+
+/**
+ * @brief The header of a snapshot. The sections follow in this order, each 8 byte aligned.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t schema_hash;
+    uint32_t option_count;
+    uint32_t occurrence_count;
+    uint32_t positional_count;
+    uint32_t has_action;
+    uint32_t action_offset;
+    uint32_t action_length;
+    uint64_t strings_size;
+};
+
+/**
+ * @brief A Value with its text as offset into the strings section
+ */
+struct SnapshotValue {
+    uint64_t bits;
+    uint32_t text_offset;
+    uint32_t text_length;
+    uint8_t type;
+    uint8_t is_set;
+    uint8_t padding[6];
+};
+
+/**
+ * @brief A parameter of the last positional list as offset into the strings section
+ */
+struct SnapshotText {
+    uint32_t offset;
+    uint32_t length;
+};
+
+static_assert( sizeof( SnapshotHeader ) % 8 == 0, "The header has to keep the sections aligned." );
+static_assert( sizeof( SnapshotValue ) == 24, "The layout of a snapshot value must not change within a version." );
+static_assert( sizeof( unsigned long ) <= sizeof( uint64_t ) && sizeof( double ) <= sizeof( uint64_t ), "Every converted value has to fit into 64 bit." );
+
+
+size_t align8( size_t size ) {
+    return ( size + 7 ) & ~static_cast< size_t >( 7 );
+}
+
+
+/**
+ * @brief Collects the texts of a snapshot
+ */
+class StringsWriter {
+    std::vector< char >& m_strings;
+
+public:
+    explicit StringsWriter( std::vector< char >& strings )
+        :   m_strings( strings )
+    {}
+
+    SnapshotText add( const StringView& text ) {
+        if ( m_strings.size() + text.length() > 0xffffffffu ) {
+            throw exceptions::SnapshotError("The texts of the parameters are too large for a snapshot.");
+        }
+        SnapshotText result;
+        result.offset = static_cast< uint32_t >( m_strings.size() );
+        result.length = static_cast< uint32_t >( text.length() );
+        m_strings.insert( m_strings.end(), text.data(), text.data() + text.length() );
+        return result;
+    }
+};
+
+
+SnapshotValue to_snapshot( const Value& value, StringsWriter& strings ) {
+    SnapshotValue result;
+    std::memset( &result, 0, sizeof( result ) );
+    std::memcpy( &result.bits, &value.as_double, sizeof( value.as_double ) );
+    const SnapshotText text = strings.add( value.text );
+    result.text_offset = text.offset;
+    result.text_length = text.length;
+    result.type = static_cast< uint8_t >( value.type );
+    result.is_set = value.is_set ? 1 : 0;
+    return result;
+}
+
+
+void append( std::vector< char >& blob, const void* data, size_t size ) {
+    const char* bytes = static_cast< const char* >( data );
+    blob.insert( blob.end(), bytes, bytes + size );
+}
+
+
+void pad( std::vector< char >& blob ) {
+    blob.resize( align8( blob.size() ), 0 );
+}
+
+
+/**
+ * @brief Reads the sections of a snapshot and turns offsets into views
+ */
+class SnapshotReader {
+    const char* m_strings;
+    uint64_t m_strings_size;
+
+public:
+    SnapshotReader( const char* strings, uint64_t strings_size )
+        :   m_strings( strings )
+        ,   m_strings_size( strings_size )
+    {}
+
+    StringView text( uint32_t offset, uint32_t length ) const {
+        if ( static_cast< uint64_t >( offset ) + length > m_strings_size ) {
+            throw exceptions::SnapshotError("The snapshot is corrupt.");
+        }
+        return StringView( m_strings + offset, length );
+    }
+
+    /**
+     * @brief Read a value, that has to have the data type of its option, so the union is never read as another member
+     */
+    Value value( const char* data, Data::Type data_type ) const {
+        SnapshotValue stored;
+        std::memcpy( &stored, data, sizeof( stored ) );
+        if ( stored.type != static_cast< uint8_t >( data_type ) ) {
+            throw exceptions::SnapshotError("The snapshot is corrupt.");
+        }
+
+        Value result( static_cast< Data::Type >( stored.type ) );
+        std::memcpy( &result.as_double, &stored.bits, sizeof( result.as_double ) );
+        result.text = this->text( stored.text_offset, stored.text_length );
+        result.is_set = stored.is_set != 0;
+        return result;
+    }
+};
+
+} // namespace
+
+
+uint64_t Snapshot::schema_hash( const CmdLineArguments& arguments ) {
+    uint64_t hash = NameIndex::hash( nullptr, 0 );
+    for ( uint32_t id = 0; id < arguments.option_count(); id++ ) {
+        const Option& option = arguments.option_by_id( id );
+        hash = ( hash ^ NameIndex::hash( option.option().data(), option.option().length() ) ) * 0x100000001b3ull;
+        hash = ( hash ^ static_cast< uint64_t >( option.dataType() ) ) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+
+void Snapshot::write( const CmdLineArguments& arguments
+                    , const CmdLineParameters& parameters
+                    , std::vector< char >& blob
+) {
+    if ( !parameters.m_pending_ids.empty() ) {
+        throw std::logic_error("The parameters have to be finished before a snapshot is written.");
+    }
+
+    std::vector< char > strings;
+    StringsWriter writer( strings );
+
+    SnapshotHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, snapshot_magic, sizeof( header.magic ) );
+    header.version = Snapshot::version;
+    header.byte_order = snapshot_byte_order;
+    header.schema_hash = Snapshot::schema_hash( arguments );
+    header.option_count = static_cast< uint32_t >( parameters.m_values.size() );
+    header.occurrence_count = static_cast< uint32_t >( parameters.m_occurrences.size() );
+    header.positional_count = static_cast< uint32_t >( parameters.m_last_positionals.size() );
+
+    blob.clear();
+    blob.resize( sizeof( header ), 0 );
+
+    for ( size_t v = 0; v < parameters.m_values.size(); v++ ) {
+        const SnapshotValue value = to_snapshot( parameters.m_values[v], writer );
+        append( blob, &value, sizeof( value ) );
+    }
+    // The occurrences are ordered by option id, so the offsets follow from the number of values per option
+    uint32_t offset = 0;
+    for ( size_t v = 0; v < parameters.m_values.size(); v++ ) {
+        append( blob, &offset, sizeof( offset ) );
+        offset += parameters.m_occurrence_end[v] - parameters.m_occurrence_begin[v];
+    }
+    append( blob, &offset, sizeof( offset ) );
+    pad( blob );
+    for ( size_t o = 0; o < parameters.m_occurrences.size(); o++ ) {
+        const SnapshotValue value = to_snapshot( parameters.m_occurrences[o], writer );
+        append( blob, &value, sizeof( value ) );
+    }
+    for ( size_t p = 0; p < parameters.m_last_positionals.size(); p++ ) {
+        const SnapshotText text = writer.add( parameters.m_last_positionals[p] );
+        append( blob, &text, sizeof( text ) );
+    }
+
+    if ( parameters.m_action.length() > 0 ) {
+        const SnapshotText action = writer.add( parameters.m_action );
+        header.has_action = 1;
+        header.action_offset = action.offset;
+        header.action_length = action.length;
+    }
+    header.strings_size = strings.size();
+
+    blob.insert( blob.end(), strings.begin(), strings.end() );
+    std::memcpy( blob.data(), &header, sizeof( header ) );
+}
+
+
+void Snapshot::read( const CmdLineArguments& arguments
+                   , const char* data
+                   , size_t size
+                   , CmdLineParameters& parameters
+) {
+    SnapshotHeader header;
+    if ( size < sizeof( header ) ) {
+        throw exceptions::SnapshotError("The snapshot is truncated.");
+    }
+    std::memcpy( &header, data, sizeof( header ) );
+
+    if ( std::memcmp( header.magic, snapshot_magic, sizeof( header.magic ) ) != 0 ) {
+        throw exceptions::SnapshotError("The data is no snapshot of parameters.");
+    }
+    if ( header.byte_order != snapshot_byte_order ) {
+        throw exceptions::SnapshotError("The snapshot was written on a machine with another byte order.");
+    }
+    if ( header.version != Snapshot::version ) {
+        throw exceptions::SnapshotError("The snapshot has version " + std::to_string( header.version ) + ", but version " + std::to_string( Snapshot::version ) + " is supported.");
+    }
+    if ( header.schema_hash != Snapshot::schema_hash( arguments )
+      || header.option_count != parameters.m_values.size()
+    ) {
+        throw exceptions::SnapshotError("The snapshot was written for other options.");
+    }
+
+    // Every section has a fixed size, so one check covers the whole blob
+    const size_t values_offset = sizeof( header );
+    const size_t offsets_offset = values_offset + static_cast< size_t >( header.option_count ) * sizeof( SnapshotValue );
+    const size_t occurrences_offset = align8( offsets_offset + ( static_cast< size_t >( header.option_count ) + 1 ) * sizeof( uint32_t ) );
+    const size_t positionals_offset = occurrences_offset + static_cast< size_t >( header.occurrence_count ) * sizeof( SnapshotValue );
+    const size_t strings_offset = positionals_offset + static_cast< size_t >( header.positional_count ) * sizeof( SnapshotText );
+    if ( strings_offset > size || size - strings_offset != header.strings_size ) {
+        throw exceptions::SnapshotError("The snapshot is truncated.");
+    }
+
+    const SnapshotReader reader( data + strings_offset, header.strings_size );
+
+    for ( uint32_t v = 0; v < header.option_count; v++ ) {
+        parameters.m_values[v] = reader.value( data + values_offset + v * sizeof( SnapshotValue ), arguments.option_by_id( v ).dataType() );
+    }
+
+    std::vector< uint32_t > offsets( header.option_count + 1 );
+    std::memcpy( offsets.data(), data + offsets_offset, offsets.size() * sizeof( uint32_t ) );
+    if ( offsets.front() != 0 || offsets.back() != header.occurrence_count ) {
+        throw exceptions::SnapshotError("The snapshot is corrupt.");
+    }
+    for ( uint32_t v = 0; v < header.option_count; v++ ) {
+        if ( offsets[v] > offsets[v+1] ) {
+            throw exceptions::SnapshotError("The snapshot is corrupt.");
+        }
+    }
+
+    parameters.m_occurrences.clear();
+    parameters.m_occurrences.reserve( header.occurrence_count );
+    parameters.m_touched.clear();
+    for ( uint32_t v = 0; v < header.option_count; v++ ) {
+        const Data::Type data_type = arguments.option_by_id( v ).dataType();
+        for ( uint32_t o = offsets[v]; o < offsets[v+1]; o++ ) {
+            parameters.m_occurrences.push_back( reader.value( data + occurrences_offset + o * sizeof( SnapshotValue ), data_type ) );
+        }
+        parameters.m_occurrence_begin[v] = offsets[v];
+        parameters.m_occurrence_end[v] = offsets[v+1];
+        if ( offsets[v] < offsets[v+1] ) {
+            parameters.m_touched.push_back( v );
+        }
+    }
+
+    parameters.m_positional_storage.clear();
+    parameters.m_positional_storage.reserve( header.positional_count );
+    for ( uint32_t p = 0; p < header.positional_count; p++ ) {
+        SnapshotText text;
+        std::memcpy( &text, data + positionals_offset + p * sizeof( SnapshotText ), sizeof( text ) );
+        parameters.m_positional_storage.push_back( reader.text( text.offset, text.length ) );
+    }
+    parameters.m_last_positionals = ArgvSlice( parameters.m_positional_storage.data()
+                                             , parameters.m_positional_storage.data() + parameters.m_positional_storage.size() );
+
+    parameters.m_action = header.has_action ? reader.text( header.action_offset, header.action_length ) : StringView();
+}
+
+
+} // namespace cmdlinecpp
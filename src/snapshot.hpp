@@ -0,0 +1,90 @@
+/**
+ * @file snapshot.hpp
+ * @brief A file that defines a binary snapshot of parsed parameters, that other processes can load without parsing
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "arguments.hpp"
+#include "parameters.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief Writes parsed parameters into a binary blob and loads them back without parsing or converting them again
+ *
+ * The blob holds the converted values, all occurrences, the last positional list and the selected action.
+ * It contains no pointers, only offsets, so it can be passed to another process in a file, an inherited
+ * file descriptor or a memfd and be mapped there. The texts of the values stay in the blob and the loaded
+ * parameters point into it.
+ * The blob starts with a version and a hash of the option definitions. It can only be loaded with the same
+ * definitions on a machine with the same byte order.
+ */
+class Snapshot {
+public:
+    /**
+     * @brief The version of the format. Blobs of other versions are refused.
+     */
+    static const uint32_t version = 1;
+
+    /**
+     * @brief Write parsed parameters into a blob
+     * @param arguments The definitions the parameters were parsed for
+     * @param parameters The parameters. finish has to be called before.
+     * @param blob Is set to the snapshot
+     * @throws std::logic_error If the parameters have values that are not finished
+     * @throws SnapshotError If the texts are larger than 4 GiB
+     */
+    static void write( const CmdLineArguments& arguments
+                     , const CmdLineParameters& parameters
+                     , std::vector< char >& blob );
+    /**
+     * @brief Load parameters from a blob
+     * @param arguments The definitions the parameters were parsed for
+     * @param data The snapshot
+     * @param size The size of the snapshot in bytes
+     * @param parameters Parameters constructed for arguments without any values set
+     * @throws SnapshotError If the blob is no snapshot, has another version or byte order, was written for other definitions or is truncated
+     * @warning The texts of the values point into data, so it has to outlive the parameters
+     */
+    static void read( const CmdLineArguments& arguments
+                    , const char* data
+                    , size_t size
+                    , CmdLineParameters& parameters );
+
+    /**
+     * @brief Hash the option definitions a snapshot belongs to
+     * @param arguments The definitions
+     * @returns A hash over the names and data types of all options in the order of their ids
+     */
+    static uint64_t schema_hash( const CmdLineArguments& arguments );
+};
+
+
+} // namespace cmdlinecpp
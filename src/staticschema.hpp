@@ -0,0 +1,817 @@
+/**
+ * @file staticschema.hpp
+ * @brief A file that defines a command line schema that is built at compile time
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#if __cplusplus < 201402L && !defined(_MSC_VER)
+#error staticschema.hpp needs a compiler supporting -std=c++14 for building the schema at compile time
+#endif
+
+#include "arguments.hpp"
+#include "convert.hpp"
+#include "exceptions.hpp"
+#include "index.hpp"
+#include "stringview.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+
+namespace cmdlinecpp {
+
+
+namespace detail {
+
+/**
+ * @brief Length of a null terminated string at compile time
+ */
+constexpr size_t static_strlen( const char* str ) {
+    size_t length = 0;
+    while ( str[length] != '\0' ) {
+        ++length;
+    }
+    return length;
+}
+
+/**
+ * @brief The hash of NameIndex::hash (64 bit FNV-1a) at compile time
+ */
+constexpr uint64_t static_hash( const char* key, size_t length ) {
+    uint64_t h = 14695981039346656037ULL;
+    for ( size_t c = 0; c < length; c++ ) {
+        h ^= static_cast< unsigned char >( key[c] );
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * @brief Compare two ranges of characters at compile time
+ */
+constexpr bool static_equal( const char* lhs, size_t lhs_length, const char* rhs, size_t rhs_length ) {
+    if ( lhs_length != rhs_length ) {
+        return false;
+    }
+    for ( size_t c = 0; c < lhs_length; c++ ) {
+        if ( lhs[c] != rhs[c] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Scramble a hash with the displacement of its bucket
+ */
+constexpr uint64_t static_mix( uint64_t h, uint32_t displacement ) {
+    h ^= ( static_cast< uint64_t >( displacement ) + 1 ) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 31;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 29;
+    return h;
+}
+
+/**
+ * @brief The number of slots of a perfect hash table for a number of keys (a power of two with load factor <= 0.5)
+ */
+constexpr size_t static_table_size( size_t keys ) {
+    size_t capacity = 4;
+    while ( capacity < keys * 2 ) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace detail
+
+
+/**
+ * @brief A perfect hash table over at most Keys names that is built at compile time.
+ * @note The table uses hash and displace: Every bucket of keys gets a displacement, so that all keys land in distinct slots. A lookup is one hash, one displacement load and one key compare.
+ */
+template< size_t Keys >
+class PerfectHash {
+public:
+    /**
+     * @brief The number of slots
+     */
+    static constexpr size_t Slots = detail::static_table_size( Keys );
+    /**
+     * @brief The number of buckets that get an own displacement
+     */
+    static constexpr size_t Buckets = Keys / 2 + 1;
+
+    /**
+     * @brief A key to insert while building the table
+     */
+    struct Key {
+        const char* key;
+        uint32_t length;
+        uint32_t value;
+    };
+
+protected:
+    /**
+     * @brief One slot of the table. A slot with a nullptr as key is empty.
+     */
+    struct Slot {
+        const char* key;
+        uint32_t length;
+        uint32_t value;
+    };
+
+    Slot m_slots[Slots];
+    uint32_t m_displacements[Buckets];
+
+    static constexpr size_t bucket_of( uint64_t h ) {
+        return static_cast< size_t >( ( h >> 32 ) % Buckets );
+    }
+
+public:
+    /**
+     * @brief Constructor. Constructs an empty table.
+     */
+    constexpr PerfectHash()
+        :   m_slots{}
+        ,   m_displacements{}
+    {}
+
+    /**
+     * @brief Build the table over a list of keys
+     * @param keys The keys to insert. If a key occurs multiple times, the first value is kept.
+     * @param count The number of keys (at most Keys)
+     * @note Meant to be evaluated at compile time. A failure makes the constant expression ill-formed.
+     */
+    constexpr void build( const Key* keys, size_t count ) {
+        if ( count > Keys ) {
+            throw std::logic_error("Too many keys for this PerfectHash.");
+        }
+
+        // Sort the keys by bucket with a stable counting sort
+        uint32_t bucket_size[Buckets] = {};
+        uint32_t bucket_begin[Buckets + 1] = {};
+        for ( size_t k = 0; k < count; k++ ) {
+            ++bucket_size[ bucket_of( detail::static_hash( keys[k].key, keys[k].length ) ) ];
+        }
+        uint32_t max_size = 0;
+        for ( size_t b = 0; b < Buckets; b++ ) {
+            bucket_begin[b+1] = bucket_begin[b] + bucket_size[b];
+            if ( bucket_size[b] > max_size ) {
+                max_size = bucket_size[b];
+            }
+        }
+        uint32_t order[Keys > 0 ? Keys : 1] = {};
+        uint32_t fill[Buckets] = {};
+        for ( size_t k = 0; k < count; k++ ) {
+            const size_t b = bucket_of( detail::static_hash( keys[k].key, keys[k].length ) );
+            order[ bucket_begin[b] + fill[b]++ ] = static_cast< uint32_t >( k );
+        }
+
+        // Place the biggest buckets first, they are the hardest to place
+        for ( uint32_t size = max_size; size > 0; size-- ) {
+            for ( size_t b = 0; b < Buckets; b++ ) {
+                if ( bucket_size[b] != size ) {
+                    continue;
+                }
+                this->place_bucket( keys, order + bucket_begin[b], size, b );
+            }
+        }
+    }
+
+    /**
+     * @brief Look up a key
+     * @param key Pointer to the first character of the key
+     * @param length The length of the key
+     * @returns The value of the key or NameIndex::npos, if the key is not in this table
+     */
+    constexpr uint32_t find( const char* key, size_t length ) const {
+        const uint64_t h = detail::static_hash( key, length );
+        const Slot& slot = m_slots[ detail::static_mix( h, m_displacements[ bucket_of( h ) ] ) & ( Slots - 1 ) ];
+        if ( slot.key != nullptr && detail::static_equal( slot.key, slot.length, key, length ) ) {
+            return slot.value;
+        }
+        return NameIndex::npos;
+    }
+
+protected:
+    constexpr void place_bucket( const Key* keys, const uint32_t* members, uint32_t size, size_t bucket ) {
+        size_t slots[Keys > 0 ? Keys : 1] = {};
+        bool skip[Keys > 0 ? Keys : 1] = {};
+
+        // Duplicate names always share a bucket. The first definition wins.
+        for ( uint32_t m = 0; m < size; m++ ) {
+            for ( uint32_t n = 0; n < m; n++ ) {
+                if ( !skip[n]
+                  && detail::static_equal( keys[members[m]].key, keys[members[m]].length
+                                         , keys[members[n]].key, keys[members[n]].length )
+                ) {
+                    skip[m] = true;
+                    break;
+                }
+            }
+        }
+
+        for ( uint32_t displacement = 0; displacement < 0x100000; displacement++ ) {
+            bool placed = true;
+            for ( uint32_t m = 0; m < size && placed; m++ ) {
+                if ( skip[m] ) {
+                    continue;
+                }
+                const uint64_t h = detail::static_hash( keys[members[m]].key, keys[members[m]].length );
+                slots[m] = detail::static_mix( h, displacement ) & ( Slots - 1 );
+                if ( m_slots[ slots[m] ].key != nullptr ) {
+                    placed = false;
+                }
+                for ( uint32_t n = 0; n < m && placed; n++ ) {
+                    if ( !skip[n] && slots[n] == slots[m] ) {
+                        placed = false;
+                    }
+                }
+            }
+
+            if ( placed ) {
+                m_displacements[bucket] = displacement;
+                for ( uint32_t m = 0; m < size; m++ ) {
+                    if ( skip[m] ) {
+                        continue;
+                    }
+                    Slot& slot = m_slots[ slots[m] ];
+                    slot.key = keys[members[m]].key;
+                    slot.length = keys[members[m]].length;
+                    slot.value = keys[members[m]].value;
+                }
+                return;
+            }
+        }
+
+        throw std::logic_error("Could not find a perfect hash for the schema.");
+    }
+};
+
+
+/**
+ * @brief Defines an option of a StaticSchema. The counterpart of Option as a literal type.
+ */
+struct StaticOption {
+    const char* name;
+    size_t name_length;
+    const char* option_short;
+    size_t short_length;
+    const char* help_text;
+    Data::Type data_type;
+
+    /**
+     * @brief Default constructor. Constructs an empty positional option.
+     */
+    constexpr StaticOption()
+        :   name( "" )
+        ,   name_length( 0 )
+        ,   option_short( "" )
+        ,   short_length( 0 )
+        ,   help_text( "" )
+        ,   data_type( Data::Type::String )
+    {}
+    /**
+     * @brief Constructor for positional argument options.
+     * @param option_long The name of this positional argument option
+     * @param help_text The help text of this positional argument option
+     * @param data_type The Data::Type of this positional argument. Defaults to Data::Type::String.
+     */
+    constexpr StaticOption( const char* option_long
+                          , const char* help_text
+                          , Data::Type data_type = Data::Type::String )
+        :   name( option_long )
+        ,   name_length( detail::static_strlen( option_long ) )
+        ,   option_short( "" )
+        ,   short_length( 0 )
+        ,   help_text( help_text )
+        ,   data_type( data_type )
+    {}
+    /**
+     * @brief Constructor for regular options.
+     * @param option_long The name and long option specifier of this regular option
+     * @param option_short The short option specifier of this regular option (1-3 character)
+     * @param help_text The help text of this regular option
+     * @param data_type The Data::Type of this regular argument. Defaults to Data::Type::String.
+     * @throws logic_error If option_short is empty or longer than 3 characters. At compile time this is an error.
+     */
+    constexpr StaticOption( const char* option_long
+                          , const char* option_short
+                          , const char* help_text
+                          , Data::Type data_type = Data::Type::String )
+        :   name( option_long )
+        ,   name_length( detail::static_strlen( option_long ) )
+        ,   option_short( option_short )
+        ,   short_length( detail::static_strlen( option_short ) )
+        ,   help_text( help_text )
+        ,   data_type( data_type )
+    {
+        if ( short_length == 0 || short_length > 3 ) {
+            throw std::logic_error("The parameter option_short needs 1-3 characters.");
+        }
+    }
+
+    /**
+     * @brief Test, if this option is a positional option
+     * @returns True, if no short option specifier was given
+     */
+    constexpr bool is_positional() const {
+        return short_length == 0;
+    }
+};
+
+
+/**
+ * @brief Defines an action of a StaticSchema. The counterpart of Action as a literal type.
+ */
+struct StaticAction {
+    const char* name;
+    size_t name_length;
+    const char* help_text;
+
+    /**
+     * @brief Default constructor. Constructs an empty action.
+     */
+    constexpr StaticAction()
+        :   name( "" )
+        ,   name_length( 0 )
+        ,   help_text( "" )
+    {}
+    /**
+     * @brief Constructor.
+     * @param name The name of the action
+     * @param help_text The help text of the action
+     */
+    constexpr StaticAction( const char* name, const char* help_text )
+        :   name( name )
+        ,   name_length( detail::static_strlen( name ) )
+        ,   help_text( help_text )
+    {}
+};
+
+
+/**
+ * @brief A complete set of options and actions with perfect hash indices that are generated at compile time.
+ * @note Declare it as static constexpr, so it is placed in read-only data and costs nothing at startup:
+ *       static constexpr auto schema = cmdlinecpp::make_static_schema( options, actions );
+ * @note Option ids are numbered like in CmdLineArguments: the regular options first, then the positional options, each in definition order.
+ */
+template< size_t Options, size_t Actions >
+class StaticSchema {
+public:
+    /**
+     * @brief The size of the arrays that hold the actions. Arrays of size zero are not allowed.
+     */
+    static constexpr size_t ActionSlots = Actions > 0 ? Actions : 1;
+
+protected:
+    StaticOption m_options[Options];
+    StaticAction m_actions[ActionSlots];
+    size_t m_regular_count;
+    PerfectHash< 2 * Options > m_token_hash;
+    PerfectHash< Options > m_name_hash;
+    PerfectHash< Actions > m_action_hash;
+
+public:
+    /**
+     * @brief Constructor. Orders the options by id and builds the perfect hash tables.
+     * @param options The options in definition order
+     * @param actions The actions in definition order or nullptr, if Actions is 0
+     */
+    constexpr StaticSchema( const StaticOption* options, const StaticAction* actions )
+        :   m_options{}
+        ,   m_actions{}
+        ,   m_regular_count( 0 )
+        ,   m_token_hash()
+        ,   m_name_hash()
+        ,   m_action_hash()
+    {
+        for ( size_t o = 0; o < Options; o++ ) {
+            if ( !options[o].is_positional() ) {
+                m_options[ m_regular_count++ ] = options[o];
+            }
+        }
+        size_t id = m_regular_count;
+        for ( size_t o = 0; o < Options; o++ ) {
+            if ( options[o].is_positional() ) {
+                m_options[ id++ ] = options[o];
+            }
+        }
+        for ( size_t a = 0; a < Actions; a++ ) {
+            m_actions[a] = actions[a];
+        }
+
+        typename PerfectHash< 2 * Options >::Key tokens[ 2 * Options > 0 ? 2 * Options : 1 ] = {};
+        typename PerfectHash< Options >::Key names[ Options > 0 ? Options : 1 ] = {};
+        typename PerfectHash< Actions >::Key action_names[ActionSlots] = {};
+        size_t token_count = 0;
+        for ( uint32_t o = 0; o < Options; o++ ) {
+            const StaticOption& option = m_options[o];
+            names[o] = { option.name, static_cast< uint32_t >( option.name_length ), o };
+            if ( o < m_regular_count ) {
+                tokens[ token_count++ ] = { option.name, static_cast< uint32_t >( option.name_length ), o };
+                tokens[ token_count++ ] = { option.option_short, static_cast< uint32_t >( option.short_length ), o };
+            }
+        }
+        for ( uint32_t a = 0; a < Actions; a++ ) {
+            action_names[a] = { m_actions[a].name, static_cast< uint32_t >( m_actions[a].name_length ), a };
+        }
+
+        m_token_hash.build( tokens, token_count );
+        m_name_hash.build( names, Options );
+        m_action_hash.build( action_names, Actions );
+    }
+
+    /**
+     * @brief Get the id of a regular or positional option by its name
+     * @param option_name The name to look for
+     * @returns The id of the option or NameIndex::npos, if the option is not found
+     */
+    constexpr uint32_t id( const char* option_name ) const {
+        return m_name_hash.find( option_name, detail::static_strlen( option_name ) );
+    }
+    /**
+     * @brief Get the id of a regular or positional option by its name
+     * @param option_name The name to look for
+     * @returns The id of the option or NameIndex::npos, if the option is not found
+     */
+    uint32_t id( const StringView& option_name ) const {
+        return m_name_hash.find( option_name.data(), option_name.length() );
+    }
+    /**
+     * @brief Get the id of a regular option by the specifier passed on the command line
+     * @param parameter The specifier with one or two leading dashes
+     * @returns The id of the option or NameIndex::npos, if parameter is no regular option
+     */
+    uint32_t id_of_parameter( const StringView& parameter ) const {
+        if ( parameter.length() == 0 || parameter[0] != '-' ) {
+            return NameIndex::npos;
+        }
+        const size_t dashes = ( parameter.length() > 1 && parameter[1] == '-' ) ? 2 : 1;
+        return m_token_hash.find( parameter.data() + dashes, parameter.length() - dashes );
+    }
+    /**
+     * @brief Get the number of an action by its name
+     * @param action The name to look for
+     * @returns The number of the action in definition order or NameIndex::npos, if no action has this name
+     */
+    uint32_t action_id( const StringView& action ) const {
+        return m_action_hash.find( action.data(), action.length() );
+    }
+
+    /**
+     * @brief Get an option by its id
+     * @param id The id of the option
+     * @returns The option with this id
+     */
+    constexpr const StaticOption& option( uint32_t id ) const {
+        return m_options[id];
+    }
+    /**
+     * @brief Get an action by its number
+     * @param action The number of the action in definition order
+     * @returns The action
+     */
+    constexpr const StaticAction& action( uint32_t action ) const {
+        return m_actions[action];
+    }
+    /**
+     * @brief Get the data type of an option
+     * @param id The id of the option
+     * @returns The Data::Type of the option
+     */
+    constexpr Data::Type type( uint32_t id ) const {
+        return m_options[id].data_type;
+    }
+
+    /**
+     * @brief Get the number of options
+     * @returns The number of regular and positional options
+     */
+    constexpr size_t option_count() const {
+        return Options;
+    }
+    /**
+     * @brief Get the number of regular options
+     * @returns The number of regular options. Their ids are 0 to regular_count()-1.
+     */
+    constexpr size_t regular_count() const {
+        return m_regular_count;
+    }
+    /**
+     * @brief Get the number of positional options
+     * @returns The number of positional options. Their ids follow the regular options.
+     */
+    constexpr size_t positional_count() const {
+        return Options - m_regular_count;
+    }
+    /**
+     * @brief Get the number of actions
+     * @returns The number of actions
+     */
+    constexpr size_t action_count() const {
+        return Actions;
+    }
+};
+
+
+/**
+ * @brief Create a StaticSchema from arrays of options and actions
+ * @param options The options in definition order
+ * @param actions The actions in definition order
+ * @returns The schema with its perfect hash tables
+ */
+template< size_t Options, size_t Actions >
+constexpr StaticSchema< Options, Actions > make_static_schema( const StaticOption (&options)[Options]
+                                                             , const StaticAction (&actions)[Actions] ) {
+    return StaticSchema< Options, Actions >( options, actions );
+}
+
+
+/**
+ * @brief Create a StaticSchema without actions from an array of options
+ * @param options The options in definition order
+ * @returns The schema with its perfect hash tables
+ */
+template< size_t Options >
+constexpr StaticSchema< Options, 0 > make_static_schema( const StaticOption (&options)[Options] ) {
+    return StaticSchema< Options, 0 >( options, nullptr );
+}
+
+
+/**
+ * @brief The parameters parsed with a StaticSchema. The counterpart of CmdLineParameters.
+ * @note All values are views into the argv array. Nothing is allocated while parsing.
+ */
+template< size_t Options, size_t Actions >
+class StaticParameters {
+protected:
+    const StaticSchema< Options, Actions >& m_schema;
+    StringView m_values[ Options > 0 ? Options : 1 ];
+    bool m_given[ Options > 0 ? Options : 1 ];
+    uint32_t m_action;
+    char** m_last_positionals;
+    size_t m_last_positionals_count;
+
+    void check_type( uint32_t id, Data::Type expected, const char* type_name ) const {
+        if ( id >= Options ) {
+            throw CmdLineArguments::NotFound("Did not find the requested option.");
+        }
+        if ( m_schema.type( id ) != expected ) {
+            throw exceptions::TypeError("Expected " + std::string(type_name) + " as data type.");
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor. Constructs a class with no parameters specified.
+     * @param schema The schema to parse with
+     */
+    explicit StaticParameters( const StaticSchema< Options, Actions >& schema )
+        :   m_schema( schema )
+        ,   m_values()
+        ,   m_given()
+        ,   m_action( NameIndex::npos )
+        ,   m_last_positionals( nullptr )
+        ,   m_last_positionals_count( 0 )
+    {}
+
+    /**
+     * @brief Parse all command line parameters according to the schema
+     * @param argc The parameter argc as it can be received from the main function's parameters
+     * @param argv The parameter argv as it can be received from the main function's parameters
+     * @returns False, if there are no parameters to parse
+     * @throws std::out_of_range If no parameter is specified for an argument or if not all positional arguments are specified
+     * @note The results of a previous parse are cleared, so one object can parse many command lines.
+     */
+    bool parse( int argc, char** argv ) {
+        if ( argc == 0 ) {
+            return false;
+        }
+
+        // Nothing of a previous parse may remain
+        for ( size_t id = 0; id < Options; id++ ) {
+            m_values[id] = StringView();
+            m_given[id] = false;
+        }
+        m_action = NameIndex::npos;
+        m_last_positionals = nullptr;
+        m_last_positionals_count = 0;
+
+        size_t positionals = 0;
+        int a = 1;
+        while ( a < argc ) {
+            const StringView argument( argv[a] );
+            if ( argument == END_OF_OPTIONS ) {
+                // Everything behind -- is positional
+                for ( ++a; a < argc && positionals < m_schema.positional_count(); ++a ) {
+                    const uint32_t positional_id = static_cast< uint32_t >( m_schema.regular_count() + positionals );
+                    m_values[positional_id] = StringView( argv[a] );
+                    m_given[positional_id] = true;
+                    ++positionals;
+                    if ( positionals == m_schema.positional_count() ) {
+                        m_last_positionals = argv + a;
+                        m_last_positionals_count = static_cast< size_t >( argc - a );
+                        a = argc;
+                    }
+                }
+                if ( a < argc ) {
+                    throw std::out_of_range("Too many positional arguments.");
+                }
+                break;
+            }
+            const uint32_t id = m_schema.id_of_parameter( argument );
+            if ( id != NameIndex::npos ) {
+                m_given[id] = true;
+                if ( m_schema.type( id ) != Data::Type::Bool ) {
+                    if ( a + 1 == argc ) {
+                        throw std::out_of_range("The data type of '" + argument.str() + "' is not bool, but there are no more parameters to parse.");
+                    }
+                    m_values[id] = StringView( argv[a+1] );
+                    a += 2;
+                } else {
+                    m_values[id] = StringView( TRUE );
+                    ++a;
+                }
+            } else if ( Actions > 0 && m_schema.action_id( argument ) != NameIndex::npos ) {
+                m_action = m_schema.action_id( argument );
+                ++a;
+            } else {
+                if ( positionals >= m_schema.positional_count() ) {
+                    throw std::out_of_range("Too many positional arguments.");
+                }
+                const uint32_t positional_id = static_cast< uint32_t >( m_schema.regular_count() + positionals );
+                m_values[positional_id] = argument;
+                m_given[positional_id] = true;
+                ++positionals;
+
+                if ( positionals == m_schema.positional_count() ) {
+                    // The last positional argument takes all remaining parameters as list
+                    m_last_positionals = argv + a;
+                    m_last_positionals_count = static_cast< size_t >( argc - a );
+                    break;
+                }
+                ++a;
+            }
+        }
+
+        if ( positionals != m_schema.positional_count() ) {
+            throw std::out_of_range("Not all positional arguments are specified.");
+        }
+        return true;
+    }
+
+    /**
+     * @brief Test, if a value was given for an option
+     * @param id The id of the option, e.g. from StaticSchema::id
+     * @returns True, if the option was given on the command line
+     */
+    bool is_specified( uint32_t id ) const {
+        return id < Options && m_given[id];
+    }
+    /**
+     * @brief Get a view on the value of an option
+     * @param id The id of the option, e.g. from StaticSchema::id
+     * @returns A view into argv or an empty view, if the option was not given
+     */
+    StringView view( uint32_t id ) const {
+        return id < Options ? m_values[id] : StringView();
+    }
+    /**
+     * @brief Get the selected action
+     * @returns The number of the action in definition order or NameIndex::npos, if no action was given
+     */
+    uint32_t action() const {
+        return m_action;
+    }
+    /**
+     * @brief Get the number of last positional parameters
+     * @returns The number of elements of the last positional list. The first one is the value of the last positional argument.
+     */
+    size_t last_positionals_count() const {
+        return m_last_positionals_count;
+    }
+    /**
+     * @brief Get an element of the last positional list
+     * @param index The index in the list
+     * @returns A view into argv on the element
+     */
+    StringView last_positional( size_t index ) const {
+        return StringView( m_last_positionals[index] );
+    }
+
+    /**
+     * @brief Get the value of a Data::Type::Bool option
+     * @throws TypeError If the option has another Data::Type
+     */
+    bool get_bool( uint32_t id ) const {
+        if ( id >= Options || m_schema.type( id ) != Data::Type::Bool ) {
+            throw exceptions::TypeError("Expected bool as data type.");
+        }
+        return m_given[id];
+    }
+    /**
+     * @brief Get the value of a Data::Type::Double option
+     * @throws TypeError If the option has another Data::Type
+     */
+    double get_double( uint32_t id ) const {
+        this->check_type( id, Data::Type::Double, "double" );
+        return convert::to_double( m_values[id] );
+    }
+    /**
+     * @brief Get the value of a Data::Type::Long option
+     * @throws TypeError If the option has another Data::Type or the value is no valid number of this type
+     */
+    long get_long( uint32_t id ) const {
+        this->check_type( id, Data::Type::Long, "long" );
+        return convert::to_long( m_values[id] );
+    }
+    /**
+     * @brief Get the value of a Data::Type::Int option
+     * @throws TypeError If the option has another Data::Type or the value is no valid number of this type
+     */
+    int get_int( uint32_t id ) const {
+        this->check_type( id, Data::Type::Int, "int" );
+        return convert::to_int( m_values[id] );
+    }
+    /**
+     * @brief Get the value of a Data::Type::Short option
+     * @throws TypeError If the option has another Data::Type or the value is no valid number of this type
+     */
+    short get_short( uint32_t id ) const {
+        this->check_type( id, Data::Type::Short, "short" );
+        return convert::to_short( m_values[id] );
+    }
+    /**
+     * @brief Get the value of a Data::Type::UnsignedLong option
+     * @throws TypeError If the option has another Data::Type or the value is no valid number of this type
+     */
+    unsigned long get_unsigned_long( uint32_t id ) const {
+        this->check_type( id, Data::Type::UnsignedLong, "unsigned long" );
+        return convert::to_unsigned_long( m_values[id] );
+    }
+    /**
+     * @brief Get the value of a Data::Type::UnsignedInt option
+     * @throws TypeError If the option has another Data::Type or the value is no valid number of this type
+     */
+    unsigned int get_unsigned_int( uint32_t id ) const {
+        this->check_type( id, Data::Type::UnsignedInt, "unsigned int" );
+        return convert::to_unsigned_int( m_values[id] );
+    }
+    /**
+     * @brief Get the value of a Data::Type::UnsignedShort option
+     * @throws TypeError If the option has another Data::Type or the value is no valid number of this type
+     */
+    unsigned short get_unsigned_short( uint32_t id ) const {
+        this->check_type( id, Data::Type::UnsignedShort, "unsigned short" );
+        return convert::to_unsigned_short( m_values[id] );
+    }
+    /**
+     * @brief Get the value of a Data::Type::String option without copying it
+     * @throws TypeError If the option has another Data::Type
+     */
+    StringView get_string( uint32_t id ) const {
+        if ( id >= Options || m_schema.type( id ) != Data::Type::String ) {
+            throw exceptions::TypeError("Expected std::string as data type.");
+        }
+        return m_values[id];
+    }
+};
+
+
+/**
+ * @brief Create empty StaticParameters for a StaticSchema
+ * @param schema The schema to parse with
+ * @returns The parameters, ready for StaticParameters::parse
+ */
+template< size_t Options, size_t Actions >
+StaticParameters< Options, Actions > make_static_parameters( const StaticSchema< Options, Actions >& schema ) {
+    return StaticParameters< Options, Actions >( schema );
+}
+
+
+} // namespace cmdlinecpp
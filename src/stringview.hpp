@@ -0,0 +1,201 @@
+/**
+ * @file stringview.hpp
+ * @brief A file that defines a non-owning view on a string
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief A non-owning view on a range of characters, e.g. on one element of the argv array of a main function.
+ * @note This is a small C++11 replacement for std::string_view. The viewed characters have to outlive the view.
+ */
+class StringView {
+    const char* m_data;
+    size_t m_length;
+
+public:
+    /**
+     * @brief Returned by find, if nothing was found
+     */
+    static const size_t npos = static_cast< size_t >( -1 );
+
+    /**
+     * @brief Default constructor. Constructs an empty view.
+     */
+    StringView()
+        :   m_data( "" )
+        ,   m_length( 0 )
+    {}
+    /**
+     * @brief Constructor for a null terminated C string
+     * @param str The string to view
+     */
+    StringView( const char* str )
+        :   m_data( str )
+        ,   m_length( std::strlen( str ) )
+    {}
+    /**
+     * @brief Constructor for a range of characters
+     * @param str Pointer to the first character
+     * @param length The number of characters to view
+     */
+    StringView( const char* str, size_t length )
+        :   m_data( str )
+        ,   m_length( length )
+    {}
+    /**
+     * @brief Constructor for a view on a std::string
+     * @param str The string to view
+     * @warning The view gets invalid, if str is modified or destroyed
+     */
+    StringView( const std::string& str )
+        :   m_data( str.data() )
+        ,   m_length( str.length() )
+    {}
+
+    /**
+     * @brief Get a pointer to the first character
+     * @returns A pointer to the first character. The characters are not null terminated in general.
+     */
+    const char* data() const { return m_data; }
+    /**
+     * @brief Get the number of characters in this view
+     * @returns The number of characters in this view
+     */
+    size_t length() const { return m_length; }
+    /**
+     * @brief Get the number of characters in this view
+     * @returns The number of characters in this view
+     */
+    size_t size() const { return m_length; }
+    /**
+     * @brief Test, if this view is empty
+     * @returns True, if this view contains no characters
+     */
+    bool empty() const { return m_length == 0; }
+
+    /**
+     * @brief Access a character
+     * @param pos The position of the character
+     * @returns The character at pos
+     */
+    char operator[]( size_t pos ) const { return m_data[pos]; }
+    /**
+     * @brief Get an iterator to the first character
+     */
+    const char* begin() const { return m_data; }
+    /**
+     * @brief Get an iterator behind the last character
+     */
+    const char* end() const { return m_data + m_length; }
+
+    /**
+     * @brief Get a view on a part of this view
+     * @param pos The first character of the part
+     * @param count The maximum number of characters of the part
+     * @returns A view on the part. It is empty, if pos is behind the end of this view.
+     */
+    StringView substr( size_t pos, size_t count = npos ) const {
+        if ( pos >= m_length ) {
+            return StringView( m_data + m_length, 0 );
+        }
+        if ( count > m_length - pos ) {
+            count = m_length - pos;
+        }
+        return StringView( m_data + pos, count );
+    }
+    /**
+     * @brief Find the first position of a character
+     * @param c The character to look for
+     * @param pos The position to start at
+     * @returns The position of the character or StringView::npos
+     */
+    size_t find( char c, size_t pos = 0 ) const {
+        if ( pos >= m_length ) {
+            return npos;
+        }
+        const void* found = std::memchr( m_data + pos, c, m_length - pos );
+        return found == nullptr ? npos : static_cast< const char* >( found ) - m_data;
+    }
+    /**
+     * @brief Test, if this view begins with a given prefix
+     * @param prefix The prefix to test
+     * @returns True, if the first characters equal prefix
+     */
+    bool starts_with( const StringView& prefix ) const {
+        return m_length >= prefix.m_length
+            && std::memcmp( m_data, prefix.m_data, prefix.m_length ) == 0;
+    }
+    /**
+     * @brief Compare this view lexicographically to another one
+     * @param other The view to compare to
+     * @returns A value less than, equal to or greater than zero like std::string::compare
+     */
+    int compare( const StringView& other ) const {
+        const size_t common = m_length < other.m_length ? m_length : other.m_length;
+        const int result = common == 0 ? 0 : std::memcmp( m_data, other.m_data, common );
+        if ( result != 0 ) {
+            return result;
+        }
+        return m_length < other.m_length ? -1 : ( m_length > other.m_length ? 1 : 0 );
+    }
+
+    /**
+     * @brief Copy the viewed characters into a new std::string
+     * @returns A std::string with the viewed characters
+     */
+    std::string str() const { return std::string( m_data, m_length ); }
+};
+
+
+inline bool operator==( const StringView& lhs, const StringView& rhs ) {
+    return lhs.length() == rhs.length()
+        && ( lhs.length() == 0 || std::memcmp( lhs.data(), rhs.data(), lhs.length() ) == 0 );
+}
+
+
+inline bool operator!=( const StringView& lhs, const StringView& rhs ) {
+    return !( lhs == rhs );
+}
+
+
+inline bool operator<( const StringView& lhs, const StringView& rhs ) {
+    return lhs.compare( rhs ) < 0;
+}
+
+
+inline std::ostream& operator<<( std::ostream& os, const StringView& view ) {
+    return os.write( view.data(), view.length() );
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,203 @@
+/**
+ * @file suggestions.cpp
+ * @brief A file that defines the "Did you mean" suggestions for unknown options
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#include "config.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "suggestions.hpp"
+
+
+namespace cmdlinecpp {
+
+
+namespace {
+
+/**
+ * @brief Get the first character behind the leading dashes or 0, if there is none
+ */
+char first_letter( const StringView& word ) {
+    size_t c = 0;
+    while ( c < word.length() && word[c] == '-' ) {
+        ++c;
+    }
+    return c < word.length() ? word[c] : '\0';
+}
+
+} // namespace
+
+
+const size_t EditDistance::max_bit_parallel;
+const size_t Suggestions::max_suggestions;
+
+
+EditDistance::EditDistance( const StringView& pattern )
+    :   m_pattern( pattern )
+{
+    std::memset( m_peq, 0, sizeof( m_peq ) );
+    const size_t length = std::min( pattern.length(), max_bit_parallel );
+    for ( size_t i = 0; i < length; i++ ) {
+        m_peq[ static_cast< unsigned char >( pattern[i] ) ] |= uint64_t( 1 ) << i;
+    }
+}
+
+
+size_t EditDistance::bounded( const StringView& text, size_t limit ) const {
+    const size_t m = m_pattern.length();
+    const size_t n = text.length();
+    if ( ( m > n ? m - n : n - m ) > limit ) {
+        return limit + 1;
+    }
+    if ( m == 0 ) {
+        return n;
+    }
+    if ( m > max_bit_parallel ) {
+        return this->banded( text, limit );
+    }
+
+    // Bit i of pv and mv is set, if the distance grows or shrinks from row i to row i+1 of the current column
+    const uint64_t last = uint64_t( 1 ) << ( m - 1 );
+    uint64_t pv = ~uint64_t( 0 );
+    uint64_t mv = 0;
+    size_t score = m;
+    for ( size_t j = 0; j < n; j++ ) {
+        const uint64_t eq = m_peq[ static_cast< unsigned char >( text[j] ) ];
+        const uint64_t xv = eq | mv;
+        const uint64_t xh = ( ( ( eq & pv ) + pv ) ^ pv ) | eq;
+        uint64_t ph = mv | ~( xh | pv );
+        uint64_t mh = pv & xh;
+        if ( ph & last ) {
+            ++score;
+        } else if ( mh & last ) {
+            --score;
+        }
+        // The first row is the distance to the empty pattern, so it grows by one in every column
+        ph = ( ph << 1 ) | 1;
+        mh <<= 1;
+        pv = mh | ~( xv | ph );
+        mv = ph & xv;
+
+        // Every remaining character lowers the distance by one at most
+        if ( score > limit + ( n - j - 1 ) ) {
+            return limit + 1;
+        }
+    }
+    return score <= limit ? score : limit + 1;
+}
+
+
+size_t EditDistance::banded( const StringView& text, size_t limit ) const {
+    const size_t m = m_pattern.length();
+    const size_t n = text.length();
+    const size_t over = limit + 1;
+
+    // Only cells within limit of the diagonal can be at most limit, the others are kept at over
+    std::vector< size_t > previous( n + 1 );
+    std::vector< size_t > current( n + 1 );
+    for ( size_t j = 0; j <= n; j++ ) {
+        previous[j] = std::min( j, over );
+    }
+    for ( size_t i = 1; i <= m; i++ ) {
+        const size_t first = i > limit ? i - limit : 1;
+        const size_t last = std::min( n, i + limit );
+        current[0] = std::min( i, over );
+        if ( first > 1 ) {
+            current[ first - 1 ] = over;
+        }
+
+        size_t row_min = current[ first - 1 ];
+        for ( size_t j = first; j <= last; j++ ) {
+            const size_t cost = ( m_pattern[ i - 1 ] == text[ j - 1 ] ) ? 0 : 1;
+            const size_t cell = std::min( std::min( previous[ j - 1 ] + cost, previous[j] + 1 ), current[ j - 1 ] + 1 );
+            current[j] = std::min( cell, over );
+            row_min = std::min( row_min, current[j] );
+        }
+        if ( last < n ) {
+            current[ last + 1 ] = over;
+        }
+
+        if ( row_min > limit ) {
+            return over;
+        }
+        previous.swap( current );
+    }
+    return std::min( previous[n], over );
+}
+
+
+size_t Suggestions::limit( const StringView& word ) {
+    size_t length = word.length();
+    for ( size_t c = 0; c < word.length() && word[c] == '-'; c++ ) {
+        --length;
+    }
+    return std::max( size_t( 1 ), std::min( size_t( 3 ), length / 3 ) );
+}
+
+
+std::string Suggestions::did_you_mean( const StringView& word, const std::vector< std::string >& candidates ) {
+    const EditDistance distance( word );
+    const char letter = first_letter( word );
+
+    size_t bound = Suggestions::limit( word );
+    std::vector< size_t > matches;
+    for ( int pass = 0; pass < 2; pass++ ) {
+        // The first pass looks at the bucket with the same first letter, where a typo most likely is
+        for ( size_t c = 0; c < candidates.size(); c++ ) {
+            const StringView candidate( candidates[c] );
+            if ( ( first_letter( candidate ) == letter ) != ( pass == 0 ) ) {
+                continue;
+            }
+
+            const size_t d = distance.bounded( candidate, bound );
+            if ( d > bound ) {
+                continue;
+            }
+            if ( d < bound ) {
+                bound = d;
+                matches.clear();
+            }
+            matches.push_back( c );
+        }
+    }
+    if ( matches.empty() ) {
+        return std::string();
+    }
+
+    // Suggest them in the order they were defined
+    std::sort( matches.begin(), matches.end() );
+    const size_t count = std::min( matches.size(), max_suggestions );
+    std::string sentence = " Did you mean ";
+    for ( size_t m = 0; m < count; m++ ) {
+        if ( m > 0 ) {
+            sentence += ( m + 1 == count ) ? " or " : ", ";
+        }
+        sentence += "'" + candidates[ matches[m] ] + "'";
+    }
+    return sentence + "?";
+}
+
+
+} // namespace cmdlinecpp
@@ -0,0 +1,113 @@
+/**
+ * @file suggestions.hpp
+ * @brief A file that defines the "Did you mean" suggestions for unknown options
+ * @author Sebastian Lau <lauseb644 [at] gmail [dot] com>
+ **/
+/*
+    LibCmdLineC++: A simple parser for parsing command line arguments with C++
+    Copyright (C) 2018 Sebastian Lau <lauseb644@gmail.com>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "stringview.hpp"
+
+
+namespace cmdlinecpp {
+
+
+/**
+ * @brief Computes the edit distance of one pattern to many texts, but only up to a limit
+ *
+ * Patterns up to 64 characters use the bit-parallel algorithm of Myers in the formulation of Hyyrö,
+ * which computes a whole column of the distance matrix with a few operations on one 64 bit word.
+ * Longer patterns fall back to a band of the distance matrix around the diagonal.
+ */
+class EditDistance {
+    /**
+     * @brief The pattern the texts are compared with
+     */
+    StringView m_pattern;
+    /**
+     * @brief For every character the bits of the pattern positions it is found at
+     */
+    uint64_t m_peq[256];
+
+    /**
+     * @brief Compute the distance with the band of the distance matrix, for patterns longer than 64 characters
+     */
+    size_t banded( const StringView& text, size_t limit ) const;
+
+public:
+    /**
+     * @brief The longest pattern for the bit-parallel algorithm
+     */
+    static const size_t max_bit_parallel = 64;
+
+    /**
+     * @brief Constructor. Prepares the bit masks of the pattern.
+     * @param pattern The pattern. It has to outlive this object.
+     */
+    explicit EditDistance( const StringView& pattern );
+
+    /**
+     * @brief Compute the Levenshtein distance of the pattern to a text
+     * @param text The text
+     * @param limit The largest distance of interest
+     * @returns The distance or limit + 1, if it is larger than limit. The computation stops as soon as this is certain.
+     */
+    size_t bounded( const StringView& text, size_t limit ) const;
+};
+
+
+/**
+ * @brief Finds the names closest to an unknown name for an error message
+ * @note This is only called on the error path. Nothing is prepared for it while options are defined or parsed.
+ */
+class Suggestions {
+public:
+    /**
+     * @brief The most names that are suggested
+     */
+    static const size_t max_suggestions = 3;
+
+    /**
+     * @brief Get the largest edit distance a name may have to be suggested
+     * @param word The unknown name, maybe with leading dashes
+     * @returns One third of the length without dashes, at least 1 and at most 3
+     */
+    static size_t limit( const StringView& word );
+
+    /**
+     * @brief Find the closest candidates to an unknown name
+     * @param word The unknown name as it was given, e.g. "--iteratoins"
+     * @param candidates The known names in the same form, e.g. "--iterations" and "-n"
+     * @returns A sentence like " Did you mean '--iterations'?" or an empty string, if no candidate is close enough
+     * @note Candidates are only compared, if their length is within the limit. Those with the same first letter
+     *       are compared first, so the limit tightens to the best distance before the others are compared.
+     */
+    static std::string did_you_mean( const StringView& word, const std::vector< std::string >& candidates );
+};
+
+
+} // namespace cmdlinecpp